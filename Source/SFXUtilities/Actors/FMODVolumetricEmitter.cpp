@@ -4,24 +4,52 @@
 #include "FMODVolumetricEmitter.h"
 
 #include "SFXUtilities/Components/PolygonArea2DComponent.h"
+#include "SFXUtilities/Subsystems/VolumetricEmitterSubsystem.h"
+#include "SFXUtilities/SFXUtilities.h"
 
 #include "FMODEvent.h"
 #include "FMODAudioComponent.h"
+#include "FMODUtils.h"
 
-#if WITH_EDITOR
-#include "DrawDebugHelpers.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/PlayerController.h"
+
+#if ENABLE_DRAW_DEBUG
+#include "SFXUtilities/Utilities/DebugDrawUtils.h"
 #endif
 
 AFMODVolumetricEmitter::AFMODVolumetricEmitter()
-	: Listener(nullptr)
+	: Priority(0.f)
+	, InstanceRangeMargin(500.f)
+	, OcclusionTraceChannel(ECC_Visibility)
+	, OcclusionInterpSpeed(4.f)
+	, DistanceParameterThreshold(10.f)
+	, SpreadParameterThreshold(1.f)
+	, EmitterSubsystem(nullptr)
+	, Listener(nullptr)
 	, MaxRadius(0.f)
+	, bMaxRadiusOverridden(false)
+	, bListenerDirty(true)
+	, bAreaDirty(true)
+	, bIsWithinRadius(false)
+	, bVoiceActive(false)
+	, Occlusion(0.f)
+	, TargetOcclusion(0.f)
+	, SignedDistance(0.f)
+	, PushedSignedDistance(0.f)
+	, Spread(0.f)
+	, PushedSpread(0.f)
 {
 	PrimaryActorTick.bCanEverTick = true;
-	PrimaryActorTick.bStartWithTickEnabled = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
 	AudioComponent->SetupAttachment(RootComponent);
 
+	// Audio component only carries the event settings and the virtual position,
+	// the event is played by the pooled instance when the voice budget lets it
+	AudioComponent->bAutoActivate = false;
+
 	Area = CreateDefaultSubobject<UPolygonArea2DComponent>(TEXT("Area"));
 }
 
@@ -29,49 +57,554 @@ void AFMODVolumetricEmitter::BeginPlay()
 {
 	Super::BeginPlay();
 
-	verifyf(UpdateMaxRadius(), TEXT("Failed to set MaxRadius in AFMODVolumetricEmitter::BeginPlay"));
+	// Slices are culled by the extents indexed on activation, so the index follows their changes
+	TArray<UPolygonArea2DComponent*, TInlineAllocator<8>> SliceComponents;
+	GetComponents<UPolygonArea2DComponent>(SliceComponents);
+	for (UPolygonArea2DComponent* Slice : SliceComponents)
+	{
+		Slice->OnVerticalExtentChanged.AddUObject(this, &AFMODVolumetricEmitter::OnSliceVerticalExtentChanged);
+	}
+
+	// Streamed in levels begin play of all their emitters in one frame, the subsystem spreads the activation over several
+	EmitterSubsystem = GetWorld()->GetSubsystem<UVolumetricEmitterSubsystem>();
+	if (EmitterSubsystem != nullptr)
+	{
+		EmitterSubsystem->QueueEmitterActivation(this);
+	}
+	else
+	{
+		ActivateEmitter();
+	}
+}
+
+void AFMODVolumetricEmitter::ActivateEmitter()
+{
+	SFX_LLM_SCOPE();
+
+	TArray<UFMODAudioComponent*, TInlineAllocator<4>> LayerComponents;
+	GetComponents<UFMODAudioComponent>(LayerComponents);
+	LayerComponents.Remove(AudioComponent);
+	LayerComponents.Insert(AudioComponent, 0);
+
+	Layers.Reset(LayerComponents.Num());
+	for (UFMODAudioComponent* LayerComponent : LayerComponents)
+	{
+		// Layers are played by pooled instances like the AudioComponent, never by themselves
+		if (LayerComponent->IsPlaying())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s: layer %s should not auto activate, stopping it"), *GetName(), *LayerComponent->GetName());
+			LayerComponent->Stop();
+		}
+
+		FVolumetricEmitterLayer& Layer = Layers.AddDefaulted_GetRef();
+		Layer.AudioComponent = LayerComponent;
+		Layer.MaxRadius = MaxRadius;
+	}
+
+	if (!bMaxRadiusOverridden)
+	{
+		UpdateMaxRadius();
+	}
+
+	RootComponent->TransformUpdated.AddUObject(this, &AFMODVolumetricEmitter::OnAreaTransformUpdated);
+
+	GetComponents<UPolygonArea2DComponent>(Slices);
+	RebuildSliceIndex();
+
+	if (EmitterSubsystem != nullptr)
+	{
+		EmitterSubsystem->RegisterEmitter(this);
+	}
+
+	SetActorTickEnabled(true);
+}
+
+void AFMODVolumetricEmitter::RebuildSliceIndex()
+{
+	TArray<FFloatInterval, TInlineAllocator<8>> SliceExtents;
+	for (const UPolygonArea2DComponent* Slice : Slices)
+	{
+		SliceExtents.Add(Slice->GetVerticalExtent());
+	}
+	SliceIndex.Build(SliceExtents);
+
+	// Listener may have entered or left the range of the changed slice
+	bAreaDirty = true;
+}
+
+void AFMODVolumetricEmitter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	RootComponent->TransformUpdated.RemoveAll(this);
+	UnbindListener();
+
+	TArray<UPolygonArea2DComponent*, TInlineAllocator<8>> SliceComponents;
+	GetComponents<UPolygonArea2DComponent>(SliceComponents);
+	for (UPolygonArea2DComponent* Slice : SliceComponents)
+	{
+		Slice->OnVerticalExtentChanged.RemoveAll(this);
+	}
+
+	if (EmitterSubsystem != nullptr)
+	{
+		for (FVolumetricEmitterLayer& Layer : Layers)
+		{
+			ReleaseEventInstance(Layer);
+		}
+		bVoiceActive = false;
+
+		EmitterSubsystem->UnregisterEmitter(this);
+		EmitterSubsystem = nullptr;
+	}
+
+	// Streamed out emitters may be kept alive by the level until GC, their query data is not needed anymore
+	Layers.Empty();
+	Slices.Empty();
+	SliceIndex = FVerticalIntervalIndex();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AFMODVolumetricEmitter::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
 
-	UpdateEmitterPosition();
+	if (!ListenerComponent.IsValid() && !BindListener())
+	{
+		// No camera to subscribe to, fall back to polling the listener
+		bListenerDirty = true;
+	}
 
-#if WITH_EDITOR
-	DrawDebugSphere(GetWorld(), AudioComponent->GetComponentLocation(), MaxRadius, 20, FColor::Orange);
-#endif
+	if (bListenerDirty || bAreaDirty)
+	{
+		UpdateEmitterPosition();
+	}
+
+	UpdateOcclusion(DeltaSeconds);
 
 #if DO_CHECK
-	// Check if MaxRadius has changed at runtime
+	// Check if MaxRadius has changed at runtime, layers are checked one by one so a layer without an event does not hide the others
+	if (!bMaxRadiusOverridden)
 	{
-		float OldMaxRadius = MaxRadius;
-		if (UpdateMaxRadius())
+		for (const FVolumetricEmitterLayer& Layer : Layers)
 		{
-			checkf(OldMaxRadius == MaxRadius, TEXT("AFMODVolumetricEmitter does not support changing AttenuationRadius at runtime."));
+			float LayerMaxRadius = 0.f;
+			if (FindLayerMaxRadius(Layer, LayerMaxRadius))
+			{
+				checkf(LayerMaxRadius == Layer.MaxRadius, TEXT("AFMODVolumetricEmitter does not support changing AttenuationRadius at runtime."));
+			}
 		}
 	}
 #endif
 }
 
+void AFMODVolumetricEmitter::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	// Slices report their own polygons
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(Slices.GetAllocatedSize() + SliceIndex.GetAllocatedSize() + Layers.GetAllocatedSize());
+
+	// Pooled instances are accounted to the emitter holding them
+	for (const FVolumetricEmitterLayer& Layer : Layers)
+	{
+		if (Layer.EventInstance.IsValid() && EmitterSubsystem != nullptr)
+		{
+			CumulativeResourceSize.AddDedicatedSystemMemoryBytes(EmitterSubsystem->GetAudioBackend().GetInstanceMemory(Layer.EventInstance));
+		}
+	}
+}
+
+#if ENABLE_DRAW_DEBUG
+void AFMODVolumetricEmitter::AddDebugLines(TArray<FBatchedLine>& Lines, bool bRadius, bool bQuery) const
+{
+	// Audio component sits at the closest point found by the last query
+	const FVector EmitterLocation = AudioComponent->GetComponentLocation();
+
+	if (bRadius)
+	{
+		Utils::DebugDraw::AddSphere(Lines, EmitterLocation, MaxRadius, bIsWithinRadius ? FLinearColor(FColor::Orange) : FLinearColor::Gray, 2.f);
+	}
+
+	if (bQuery && bIsWithinRadius)
+	{
+		Utils::DebugDraw::AddLine(Lines, ListenerLocation, EmitterLocation, bVoiceActive ? FLinearColor(FColor::Cyan) : FLinearColor::Gray, 5.f);
+	}
+}
+#endif
+
+void AFMODVolumetricEmitter::SetListener(const APlayerController* NewListener)
+{
+	UnbindListener();
+
+	Listener = NewListener;
+	bListenerDirty = true;
+
+	BindListener();
+}
+
+void AFMODVolumetricEmitter::OverrideMaxRadius(float Radius)
+{
+	check(!HasActorBegunPlay());
+
+	MaxRadius = Radius;
+	bMaxRadiusOverridden = true;
+}
+
+bool AFMODVolumetricEmitter::BindListener()
+{
+	if (Listener == nullptr || Listener->PlayerCameraManager == nullptr) return false;
+
+	USceneComponent* CameraRoot = Listener->PlayerCameraManager->GetRootComponent();
+	if (CameraRoot == nullptr) return false;
+
+	CameraRoot->TransformUpdated.AddUObject(this, &AFMODVolumetricEmitter::OnListenerTransformUpdated);
+	ListenerComponent = CameraRoot;
+
+	return true;
+}
+
+void AFMODVolumetricEmitter::UnbindListener()
+{
+	if (USceneComponent* CameraRoot = ListenerComponent.Get())
+	{
+		CameraRoot->TransformUpdated.RemoveAll(this);
+	}
+	ListenerComponent.Reset();
+}
+
+void AFMODVolumetricEmitter::OnListenerTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	bListenerDirty = true;
+}
+
+void AFMODVolumetricEmitter::OnSliceVerticalExtentChanged(UPolygonArea2DComponent* Slice)
+{
+	RebuildSliceIndex();
+}
+
+void AFMODVolumetricEmitter::OnAreaTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	bAreaDirty = true;
+}
+
 void AFMODVolumetricEmitter::UpdateEmitterPosition()
 {
-	if (!UpdateListenerLocation())
+	if (Listener == nullptr) return;
+
+	const bool bListenerMoved = bListenerDirty && UpdateListenerLocation();
+	const bool bAreaMoved = bAreaDirty;
+
+	bListenerDirty = false;
+	bAreaDirty = false;
+
+	if (!bListenerMoved && !bAreaMoved)
 	{
-		// Listener location did not check
+		// Neither the listener nor the area has actually moved
 		return;
 	}
 
-	FVector LocalListenerPosition = ListenerLocation - GetActorLocation();
-	if (!Area->IsWithinRadius(LocalListenerPosition, MaxRadius))
+	const FVector LocalListenerPosition = Area->WorldToArea(ListenerLocation);
+	const float InstanceRadius = Area->WorldToAreaRadius(MaxRadius + InstanceRangeMargin);
+	const float Radius = Area->WorldToAreaRadius(MaxRadius);
+
+	FVolumetricQueryRecorder* Recorder = EmitterSubsystem != nullptr ? EmitterSubsystem->GetRecorder() : nullptr;
+
+	// Slices on other floors cost nothing
+	TArray<int32, TInlineAllocator<8>> SliceIndices;
+	SliceIndex.FindOverlapping(LocalListenerPosition.Z - InstanceRadius, LocalListenerPosition.Z + InstanceRadius, SliceIndices);
+
+	bIsWithinRadius = false;
+
+	// Layers only differ in radius, so they are sorted out by the distance to the nearest slice bounds
+	const float InstanceRadiusSqr = InstanceRadius * InstanceRadius;
+	const float RadiusSqr = Radius * Radius;
+	float ClosestBoundsDistSqr = MAX_FLT;
+
+	FVector ClosestPoint = FVector::ZeroVector;
+	float ClosestPointDistSqr = MAX_FLT;
+	const UPolygonArea2DComponent* ClosestSlice = nullptr;
+
+	// Signed distance comes from the same query, only when some event wants it
+	const bool bNeedsSignedDistance = !DistanceParameter.IsNone();
+	float ClosestSignedDistance = MAX_FLT;
+
+	for (int32 Index : SliceIndices)
+	{
+		UPolygonArea2DComponent* Slice = Slices[Index];
+		const float BoundsDistSqr = Slice->GetBoundsDistSquared(LocalListenerPosition);
+		if (BoundsDistSqr > InstanceRadiusSqr) continue;
+
+		ClosestBoundsDistSqr = FMath::Min(ClosestBoundsDistSqr, BoundsDistSqr);
+
+		// One closest point query for all layers, made for the largest of them
+		const bool bSliceWithinRadius = BoundsDistSqr <= RadiusSqr;
+		float SliceSignedDistance = MAX_FLT;
+		FVector SliceClosestPoint = FVector::ZeroVector;
+		if (bSliceWithinRadius)
+		{
+			SliceClosestPoint = bNeedsSignedDistance
+				? Slice->FindClosestPoint(LocalListenerPosition, SliceSignedDistance)
+				: Slice->FindClosestPoint(LocalListenerPosition);
+		}
+
+		if (Recorder != nullptr)
+		{
+			Recorder->RecordQuery(Slice, LocalListenerPosition, Radius, bSliceWithinRadius, SliceClosestPoint);
+		}
+
+		if (!bSliceWithinRadius) continue;
+
+		bIsWithinRadius = true;
+
+		const float DistSqr = FVector::DistSquared(SliceClosestPoint, LocalListenerPosition);
+		if (DistSqr < ClosestPointDistSqr)
+		{
+			ClosestPoint = SliceClosestPoint;
+			ClosestPointDistSqr = DistSqr;
+			ClosestSlice = Slice;
+		}
+
+		// Deepest slice wins when the listener is inside several
+		ClosestSignedDistance = FMath::Min(ClosestSignedDistance, SliceSignedDistance);
+	}
+
+	for (FVolumetricEmitterLayer& Layer : Layers)
+	{
+		Layer.bIsWithinInstanceRange = ClosestBoundsDistSqr <= FMath::Square(Area->WorldToAreaRadius(Layer.MaxRadius + InstanceRangeMargin));
+	}
+
+	UpdateEventInstances();
+
+	if (!bIsWithinRadius)
 	{
 		// Listener is outside sound attenuation radius
 		return;
 	}
 
-	FVector ClosestPoint = Area->FindClosestPoint(LocalListenerPosition);
-
+	// Root shares the actor transform, so the area space point maps back to the world through the relative location
 	AudioComponent->SetRelativeLocation(ClosestPoint);
+
+	// Listener inside the area is not traced (see GetOcclusionTrace), so no trace result would ever clear the occlusion
+	if (ListenerLocation.Equals(AudioComponent->GetComponentLocation()))
+	{
+		TargetOcclusion = 0.f;
+	}
+
+	Update3DAttributes();
+
+	if (bNeedsSignedDistance)
+	{
+		SignedDistance = Area->AreaToWorldDistance(ClosestSignedDistance);
+		UpdateDistanceParameter();
+	}
+
+	// Only the slice the emitter plays from is measured, stacked slices rarely overlap in the listener view
+	if (!SpreadParameter.IsNone() && ClosestSlice != nullptr)
+	{
+		Spread = FMath::RadiansToDegrees(ClosestSlice->FindAngularExtent(LocalListenerPosition));
+		UpdateSpreadParameter();
+	}
+}
+
+float AFMODVolumetricEmitter::GetAudibility() const
+{
+	if (Listener == nullptr || !bIsWithinRadius || MaxRadius <= 0.f) return 0.f;
+
+	const float Distance = FVector::Dist(ListenerLocation, AudioComponent->GetComponentLocation());
+	if (Distance >= MaxRadius) return 0.f;
+
+	return (1.f - Distance / MaxRadius) + Priority;
+}
+
+void AFMODVolumetricEmitter::SetVoiceActive(bool bActive)
+{
+	if (bVoiceActive == bActive) return;
+
+	// Emitters without instances (events are not loaded) stay virtual
+	const bool bHasInstance = Layers.ContainsByPredicate([](const FVolumetricEmitterLayer& Layer) { return Layer.EventInstance.IsValid(); });
+	if (!bHasInstance)
+	{
+		bVoiceActive = false;
+		return;
+	}
+
+	// Layers take one voice together, each layer event fades out beyond its own attenuation
+	bVoiceActive = bActive;
+	if (bVoiceActive)
+	{
+		Update3DAttributes();
+
+		// Stopped instances kept the occlusion they had, traces of the voice start over from unoccluded
+		if (!OcclusionParameter.IsNone())
+		{
+			SetParameter(OcclusionParameter, Occlusion);
+		}
+	}
+	else
+	{
+		// Virtual emitters are not traced, so their occlusion would be stale when they get the voice back
+		Occlusion = 0.f;
+		TargetOcclusion = 0.f;
+	}
+
+	IVolumetricAudioBackend& AudioBackend = EmitterSubsystem->GetAudioBackend();
+	for (const FVolumetricEmitterLayer& Layer : Layers)
+	{
+		if (!Layer.EventInstance.IsValid()) continue;
+
+		if (bVoiceActive)
+		{
+			AudioBackend.Start(Layer.EventInstance);
+		}
+		else
+		{
+			AudioBackend.Stop(Layer.EventInstance);
+		}
+	}
+}
+
+void AFMODVolumetricEmitter::UpdateEventInstances()
+{
+	bool bHasInstance = false;
+
+	for (FVolumetricEmitterLayer& Layer : Layers)
+	{
+		if (Layer.bIsWithinInstanceRange && !Layer.EventInstance.IsValid())
+		{
+			AcquireEventInstance(Layer);
+		}
+		else if (!Layer.bIsWithinInstanceRange && Layer.EventInstance.IsValid())
+		{
+			ReleaseEventInstance(Layer);
+		}
+
+		bHasInstance |= Layer.EventInstance.IsValid();
+	}
+
+	if (!bHasInstance)
+	{
+		bVoiceActive = false;
+	}
+}
+
+void AFMODVolumetricEmitter::AcquireEventInstance(FVolumetricEmitterLayer& Layer)
+{
+	if (EmitterSubsystem == nullptr) return;
+
+	SFX_LLM_SCOPE();
+
+	// Backend decides whether the event can play, the null one plays emitters without events too
+	IVolumetricAudioBackend& AudioBackend = EmitterSubsystem->GetAudioBackend();
+	Layer.EventInstance = AudioBackend.AcquireInstance(Layer.AudioComponent->Event.Get());
+	if (!Layer.EventInstance.IsValid()) return;
+
+	// Pooled instances keep settings of their previous emitter (-1 restores the Studio values)
+	const FFMODAttenuationDetails& Attenuation = Layer.AudioComponent->AttenuationDetails;
+	AudioBackend.SetAttenuation(Layer.EventInstance,
+		Attenuation.bOverrideAttenuation ? Attenuation.MinimumDistance : -1.f,
+		Attenuation.bOverrideAttenuation ? Attenuation.MaximumDistance : -1.f);
+
+	if (!OcclusionParameter.IsNone())
+	{
+		AudioBackend.SetParameter(Layer.EventInstance, OcclusionParameter, Occlusion);
+	}
+
+	if (!DistanceParameter.IsNone())
+	{
+		AudioBackend.SetParameter(Layer.EventInstance, DistanceParameter, SignedDistance);
+	}
+
+	if (!SpreadParameter.IsNone())
+	{
+		AudioBackend.SetParameter(Layer.EventInstance, SpreadParameter, Spread);
+	}
+
+	// Layer coming into range joins the voice its siblings already play
+	if (bVoiceActive)
+	{
+		AudioBackend.Set3DAttributes(Layer.EventInstance, AudioComponent->GetComponentTransform());
+		AudioBackend.Start(Layer.EventInstance);
+	}
+}
+
+void AFMODVolumetricEmitter::ReleaseEventInstance(FVolumetricEmitterLayer& Layer)
+{
+	if (!Layer.EventInstance.IsValid()) return;
+
+	if (EmitterSubsystem != nullptr)
+	{
+		EmitterSubsystem->GetAudioBackend().ReleaseInstance(Layer.AudioComponent->Event.Get(), Layer.EventInstance);
+	}
+
+	Layer.EventInstance.Invalidate();
+}
+
+void AFMODVolumetricEmitter::Update3DAttributes()
+{
+	if (EmitterSubsystem == nullptr) return;
+
+	// All layers play at the virtual position carried by the AudioComponent
+	const FTransform& Transform = AudioComponent->GetComponentTransform();
+	for (const FVolumetricEmitterLayer& Layer : Layers)
+	{
+		if (Layer.EventInstance.IsValid())
+		{
+			EmitterSubsystem->GetAudioBackend().Set3DAttributes(Layer.EventInstance, Transform);
+		}
+	}
+}
+
+void AFMODVolumetricEmitter::SetParameter(FName Name, float Value)
+{
+	if (EmitterSubsystem == nullptr) return;
+
+	for (const FVolumetricEmitterLayer& Layer : Layers)
+	{
+		if (Layer.EventInstance.IsValid())
+		{
+			EmitterSubsystem->GetAudioBackend().SetParameter(Layer.EventInstance, Name, Value);
+		}
+	}
+}
+
+bool AFMODVolumetricEmitter::GetOcclusionTrace(FVector& OutStart, FVector& OutEnd) const
+{
+	if (OcclusionParameter.IsNone() || !bVoiceActive) return false;
+
+	OutStart = ListenerLocation;
+	OutEnd = AudioComponent->GetComponentLocation();
+
+	// Listener standing inside the area is never occluded from it
+	return !OutStart.Equals(OutEnd);
+}
+
+void AFMODVolumetricEmitter::UpdateOcclusion(float DeltaSeconds)
+{
+	if (OcclusionParameter.IsNone() || Occlusion == TargetOcclusion) return;
+
+	Occlusion = FMath::FInterpTo(Occlusion, TargetOcclusion, DeltaSeconds, OcclusionInterpSpeed);
+	if (FMath::IsNearlyEqual(Occlusion, TargetOcclusion, 1.e-3f))
+	{
+		Occlusion = TargetOcclusion;
+	}
+
+	SetParameter(OcclusionParameter, Occlusion);
+}
+
+void AFMODVolumetricEmitter::UpdateDistanceParameter()
+{
+	if (FMath::Abs(SignedDistance - PushedSignedDistance) <= DistanceParameterThreshold) return;
+
+	SetParameter(DistanceParameter, SignedDistance);
+	PushedSignedDistance = SignedDistance;
+}
+
+void AFMODVolumetricEmitter::UpdateSpreadParameter()
+{
+	if (FMath::Abs(Spread - PushedSpread) <= SpreadParameterThreshold) return;
+
+	SetParameter(SpreadParameter, Spread);
+	PushedSpread = Spread;
 }
 
 bool AFMODVolumetricEmitter::UpdateListenerLocation()
@@ -89,30 +622,38 @@ bool AFMODVolumetricEmitter::UpdateListenerLocation()
 	return true;
 }
 
-// Would be much better if cached, but UFMODAudioComponent does not have attenuation radius OnChanged callbacks
-bool AFMODVolumetricEmitter::UpdateMaxRadius()
+bool AFMODVolumetricEmitter::FindLayerMaxRadius(const FVolumetricEmitterLayer& Layer, float& OutMaxRadius) const
 {
-	if (!IsValid(AudioComponent) || !AudioComponent->Event.IsValid()) return false;
+	const UFMODAudioComponent* LayerComponent = Layer.AudioComponent;
+	if (EmitterSubsystem == nullptr || !IsValid(LayerComponent)) return false;
 
-	FMOD::Studio::EventDescription* EventDesc =
-		IFMODStudioModule::Get().GetEventDescription(AudioComponent->Event.Get(), EFMODSystemContext::Auditioning);
+	float EventMaxDistance = 0.f;
+	if (!EmitterSubsystem->GetAudioBackend().GetMaxDistance(LayerComponent->Event.Get(), EventMaxDistance)) return false;
 
-	if (EventDesc == nullptr) return false;
-	
-	bool bIs3D = false;
-	EventDesc->is3D(&bIs3D);
+	OutMaxRadius = LayerComponent->AttenuationDetails.bOverrideAttenuation
+		? FMODUtils::DistanceToUEScale(LayerComponent->AttenuationDetails.MaximumDistance)
+		: EventMaxDistance;
 
-	if (!bIs3D) return false;
+	return true;
+}
 
-	if (AudioComponent->AttenuationDetails.bOverrideAttenuation)
-	{
-		MaxRadius = AudioComponent->AttenuationDetails.MaximumDistance;
-	}
-	else
+// Would be much better if cached, but UFMODAudioComponent does not have attenuation radius OnChanged callbacks
+void AFMODVolumetricEmitter::UpdateMaxRadius()
+{
+	float LargestRadius = 0.f;
+
+	for (FVolumetricEmitterLayer& Layer : Layers)
 	{
-		EventDesc->getMaximumDistance(&MaxRadius);
+		if (!FindLayerMaxRadius(Layer, Layer.MaxRadius))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s: layer %s has no loaded event, it is never heard"), *GetName(), *GetNameSafe(Layer.AudioComponent));
+			Layer.MaxRadius = 0.f;
+			continue;
+		}
+
+		LargestRadius = FMath::Max(LargestRadius, Layer.MaxRadius);
 	}
-	MaxRadius = FMODUtils::DistanceToUEScale(MaxRadius);
 
-	return true;
+	// Area query is made once for the largest layer
+	MaxRadius = LargestRadius;
 }
\ No newline at end of file
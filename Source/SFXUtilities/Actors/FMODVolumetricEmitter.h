@@ -4,12 +4,41 @@
 
 #include "CoreMinimal.h"
 #include "FMODAmbientSound.h"
+#include "Engine/EngineTypes.h"
+
+#include "SFXUtilities/Utilities/VerticalIntervalIndex.h"
+#include "SFXUtilities/Utilities/VolumetricAudioBackend.h"
+
 #include "FMODVolumetricEmitter.generated.h"
 
+class UFMODAudioComponent;
+struct FBatchedLine;
 class UPolygonArea2DComponent;
+class UVolumetricEmitterSubsystem;
+
+/** Event layer of the volumetric emitter, layers share the area query and differ in the event and its attenuation */
+USTRUCT()
+struct FVolumetricEmitterLayer
+{
+	GENERATED_BODY()
+
+	/** Carries the event, its attenuation settings and parameters */
+	UPROPERTY()
+	UFMODAudioComponent* AudioComponent = nullptr;
+
+	float MaxRadius = 0.f;
+
+	/** Is the listener within MaxRadius + InstanceRangeMargin from the area */
+	bool bIsWithinInstanceRange = false;
+
+	/** Pooled instance, owned while the listener is within the instance range */
+	FVolumetricAudioInstance EventInstance;
+};
 
 /**
- * 
+ * Plays events at the point of its areas closest to the listener
+ * Wind, birds and insects over one region are layers of one emitter: every FMOD audio component of the actor
+ * (the AudioComponent first, extra ones with Auto Activate off) is a layer with its own attenuation, all layers share one area query
  */
 UCLASS()
 class SFXUTILITIES_API AFMODVolumetricEmitter : public AFMODAmbientSound
@@ -21,26 +50,188 @@ public:
 
 	void Tick(float DeltaSeconds) override;
 
+	// Begin UObject interface
+	/** Adds the slice index and the memory of the event instance currently owned by the emitter */
+	void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+	// End UObject interface
+
 	UFUNCTION(BlueprintCallable)
-	void SetListener(const APlayerController* NewListener) { Listener = NewListener; }
+	void SetListener(const APlayerController* NewListener);
+
+	/**
+	 * Returns estimated audibility, used to rank emitters for the voice budget:
+	 * 0 when out of range, otherwise closeness of the virtual position relative to MaxRadius plus Priority
+	 */
+	float GetAudibility() const;
+
+	bool IsVoiceActive() const { return bVoiceActive; }
+
+	/** Starts or stops the event instance (if the emitter has one), called by the voice budget */
+	void SetVoiceActive(bool bActive);
+
+	/** Returns false if occlusion is not needed, otherwise returns the listener-to-emitter segment to trace */
+	bool GetOcclusionTrace(FVector& OutStart, FVector& OutEnd) const;
+	ECollisionChannel GetOcclusionTraceChannel() const { return OcclusionTraceChannel; }
+
+	/** Sets the occlusion value the emitter smoothly goes to, called when a trace result arrives */
+	void SetOcclusionTarget(float NewTargetOcclusion) { TargetOcclusion = NewTargetOcclusion; }
+
+	UPolygonArea2DComponent* GetArea() const { return Area; }
+
+	/** Largest MaxRadius of the layers */
+	float GetMaxRadius() const { return MaxRadius; }
+
+#if ENABLE_DRAW_DEBUG
+	/** Adds the max radius sphere and the listener to closest point segment (while in range) to the debug line batch */
+	void AddDebugLines(TArray<FBatchedLine>& Lines, bool bRadius, bool bQuery) const;
+#endif
+
+	/** Uses Radius instead of the event attenuation of every layer, for emitters spawned without a loaded event (e.g. automation tests), must be called before BeginPlay */
+	void OverrideMaxRadius(float Radius);
+
+	/**
+	 * Gathers layers and slices, looks up the event max distances and starts ticking
+	 * Called by the subsystem some frames after BeginPlay, within the per-frame activation budget
+	 */
+	void ActivateEmitter();
 
 protected:
 	void BeginPlay() override;
+	void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
 	void UpdateEmitterPosition();
 
-	/** Returns false if failed to update max radius */
-	bool UpdateMaxRadius();
+	/** Subscribes to the listener camera movement, returns false if the listener has no camera yet */
+	bool BindListener();
+	void UnbindListener();
+
+	void OnListenerTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+	void OnAreaTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+	void OnSliceVerticalExtentChanged(UPolygonArea2DComponent* Slice);
+
+	/** Rebuilds the vertical culling index of the Slices, which is empty before activation */
+	void RebuildSliceIndex();
+
+	/** Looks up the attenuation radius of the Layer event, returns false if the event is not set or not loaded */
+	bool FindLayerMaxRadius(const FVolumetricEmitterLayer& Layer, float& OutMaxRadius) const;
+
+	/** Sets MaxRadius of every layer and of the emitter, layers without an event get zero radius and are never heard */
+	void UpdateMaxRadius();
 
 	/** Returns false if listener location has not changed */
 	bool UpdateListenerLocation();
 
+	/** Interpolates occlusion to the traced target and pushes it to FMOD */
+	void UpdateOcclusion(float DeltaSeconds);
+
+	/** Pushes the signed distance to FMOD if it has changed by more than DistanceParameterThreshold */
+	void UpdateDistanceParameter();
+
+	/** Pushes the spread to FMOD if it has changed by more than SpreadParameterThreshold */
+	void UpdateSpreadParameter();
+
+	/** Takes layer event instances from the pool when the listener comes close and gives them back when the listener leaves */
+	void UpdateEventInstances();
+	void AcquireEventInstance(FVolumetricEmitterLayer& Layer);
+	void ReleaseEventInstance(FVolumetricEmitterLayer& Layer);
+
+	/** Moves the event instances to the virtual emitter position */
+	void Update3DAttributes();
+
+	/** Sets the parameter of all layer instances */
+	void SetParameter(FName Name, float Value);
+
 	UPROPERTY(VisibleAnywhere)
 	UPolygonArea2DComponent* Area;
 
+	/**
+	 * All areas of the actor (including the Area), stacked floors or cave levels are extra areas with their own vertical extents
+	 * Areas share the actor space, the closest of them gives the emitter position
+	 */
+	UPROPERTY(Transient)
+	TArray<UPolygonArea2DComponent*> Slices;
+
+	/** Vertical extents of the Slices, so slices on other floors are culled without touching their polygons */
+	FVerticalIntervalIndex SliceIndex;
+
+	/** Event layers, the first one is the AudioComponent */
+	UPROPERTY(Transient)
+	TArray<FVolumetricEmitterLayer> Layers;
+
+	/** Audibility bonus when competing for the voice budget */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Voice, meta = (AllowPrivateAccess = "true", ClampMin = "0.0"))
+	float Priority;
+
+	/** Distance beyond MaxRadius, at which the event instance is taken from the pool in advance */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Voice, meta = (AllowPrivateAccess = "true", ClampMin = "0.0"))
+	float InstanceRangeMargin;
+
+	/** FMOD parameter receiving the smoothed occlusion between the listener and the area (disabled if None) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Occlusion, meta = (AllowPrivateAccess = "true"))
+	FName OcclusionParameter;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Occlusion, meta = (AllowPrivateAccess = "true"))
+	TEnumAsByte<ECollisionChannel> OcclusionTraceChannel;
+
+	/** How fast the occlusion parameter follows trace results */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Occlusion, meta = (AllowPrivateAccess = "true", ClampMin = "0.0"))
+	float OcclusionInterpSpeed;
+
+	/**
+	 * FMOD parameter receiving the signed distance from the listener to the area boundary (disabled if None)
+	 * Positive outside, negative inside (minus the depth), so events can crossfade edge and deep layers
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Distance, meta = (AllowPrivateAccess = "true"))
+	FName DistanceParameter;
+
+	/** Smaller signed distance changes are not pushed to FMOD */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Distance, meta = (AllowPrivateAccess = "true", ClampMin = "0.0"))
+	float DistanceParameterThreshold;
+
+	/**
+	 * FMOD parameter receiving the angle (degrees, 0 - 360) the closest area spans as seen from the listener (disabled if None)
+	 * Meant to drive the event spread or extent, so one emitter sounds as wide as its area instead of a point source
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Spread, meta = (AllowPrivateAccess = "true"))
+	FName SpreadParameter;
+
+	/** Smaller spread changes (degrees) are not pushed to FMOD */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Spread, meta = (AllowPrivateAccess = "true", ClampMin = "0.0"))
+	float SpreadParameterThreshold;
+
+	UPROPERTY(Transient)
+	UVolumetricEmitterSubsystem* EmitterSubsystem;
+
 	const APlayerController* Listener;
 
+	/** Listener camera component, which movement marks the listener dirty */
+	TWeakObjectPtr<USceneComponent> ListenerComponent;
+
 	FVector ListenerLocation;
+
+	/** Largest MaxRadius of the layers */
 	float MaxRadius;
+	bool bMaxRadiusOverridden;
+
+	/** Dirty flags set by transform callbacks, emitter does nothing while both are clear */
+	bool bListenerDirty;
+	bool bAreaDirty;
+
+	/** Is the listener within MaxRadius of any layer */
+	bool bIsWithinRadius;
+
+	/** Is the emitter given a voice by the budget */
+	bool bVoiceActive;
+
+	float Occlusion;
+	float TargetOcclusion;
+
+	/** Latest signed distance (world space) and the one FMOD has got */
+	float SignedDistance;
+	float PushedSignedDistance;
+
+	/** Latest spread (degrees) and the one FMOD has got */
+	float Spread;
+	float PushedSpread;
 };
@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "VolumetricReplayCommandlet.h"
+
+#include "SFXUtilities/Utilities/VolumetricQueryRecording.h"
+
+#include "Misc/Parse.h"
+
+UVolumetricReplayCommandlet::UVolumetricReplayCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UVolumetricReplayCommandlet::Main(const FString& Params)
+{
+	FString Filename;
+	if (!FParse::Value(*Params, TEXT("file="), Filename))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Missing -file=<Recording.vqr>"));
+		return 1;
+	}
+
+	int32 Iterations = 1;
+	FParse::Value(*Params, TEXT("iterations="), Iterations);
+
+	float Tolerance = 0.01f;
+	FParse::Value(*Params, TEXT("tolerance="), Tolerance);
+
+	FVolumetricQueryRecording Recording;
+	if (!Recording.LoadFromFile(Filename))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to load volumetric queries from %s"), *Filename);
+		return 1;
+	}
+
+	const FVolumetricReplayResult Result = ReplayVolumetricQueries(Recording, Tolerance, FMath::Max(Iterations, 1));
+
+	UE_LOG(LogTemp, Display, TEXT("Replayed %d frames, %d areas, %d queries in %.3f ms (%.3f us per query), %d mismatches"),
+		Recording.Frames.Num(), Recording.Areas.Num(), Result.NumQueries, Result.QuerySeconds * 1000.0,
+		Result.NumQueries > 0 ? Result.QuerySeconds * 1000000.0 / Result.NumQueries : 0.0, Result.NumMismatches);
+
+	return Result.NumMismatches > 0 ? 1 : 0;
+}
\ No newline at end of file
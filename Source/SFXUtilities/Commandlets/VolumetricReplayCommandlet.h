@@ -0,0 +1,25 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "VolumetricReplayCommandlet.generated.h"
+
+/**
+ * Replays recorded volumetric queries headlessly and reports their cost and mismatches
+ * Usage: UE4Editor-Cmd <Project> -run=VolumetricReplay -file=<Recording.vqr> [-iterations=1] [-tolerance=0.01] -nullrhi
+ * Returns 1 if any replayed query differs from the recorded one
+ */
+UCLASS()
+class SFXUTILITIES_API UVolumetricReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UVolumetricReplayCommandlet();
+
+	// Begin UCommandlet interface
+	int32 Main(const FString& Params) override;
+	// End UCommandlet interface
+};
\ No newline at end of file
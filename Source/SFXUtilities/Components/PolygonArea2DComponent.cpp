@@ -5,16 +5,54 @@
 #include "SFXUtilities/Utilities/ArrayUtils.h"
 #include "SFXUtilities/Utilities/FMathUtils.h"
 #include "SFXUtilities/Utilities/VectorUtils.h"
+#include "SFXUtilities/Subsystems/PolygonAreaSubsystem.h"
+#include "SFXUtilities/SFXUtilities.h"
+
+#include "Algo/Sort.h"
+#include "Async/Async.h"
+
+#if ENABLE_DRAW_DEBUG
+#include "SFXUtilities/Utilities/DebugDrawUtils.h"
+#endif
 
 #if WITH_EDITOR
-#include "DrawDebugHelpers.h"
+#include "SFXUtilities/Utilities/PolygonSimplification.h"
+
+#include "HAL/PlatformTime.h"
+#include "UObject/Package.h"
 #endif
 
 namespace
 {
+	// Polygons with fewer points are cheaper to rebuild in place than to hand over to a worker
+	constexpr int32 MinPointsForAsyncRebuild = 256;
+
+	/** Query trace of the game queries, does nothing */
+	struct FNoQueryTrace
+	{
+		FORCEINLINE void Sector(const FVector2D& A, const FVector2D& B) {}
+		FORCEINLINE void Side(const FVector2D& A, const FVector2D& B) {}
+
+		static constexpr bool bUseLevels = true;
+	};
+
+#if WITH_EDITOR
+	/** Query trace counting the work done for the query cost heatmap */
+	struct FQueryCostTrace
+	{
+		FPolygonAreaQueryStats Stats;
+
+		void Sector(const FVector2D& A, const FVector2D& B) { Stats.bSectorTested = true; }
+		void Side(const FVector2D& A, const FVector2D& B) { Stats.NumSidesVisited++; }
+
+		// Heatmap shows the cost of the full polygon, as MeasureQuerySeconds does, not of the level picked for the location
+		static constexpr bool bUseLevels = false;
+	};
+#endif
+
 	/** Returns index of any element X such that Pred(X) == true (or INDEX_NONE if not found) */
 	template<class T, class Pred>
-	int32 FindAnyPoint(const TArray<T>& Points, Pred IsOK)
+	int32 FindAnyPoint(TArrayView<const T> Points, Pred IsOK)
 	{
 		int32 N = Points.Num();
 
@@ -66,21 +104,33 @@ namespace
 
 // Sets default values for this component's properties
 UPolygonArea2DComponent::UPolygonArea2DComponent()
-	: MinBox(FVector2D(-150.f), FVector2D(150.f))
+	: AreaSubsystem(nullptr)
+	, bHasQueuedPoints(false)
+	, WorldToAreaMatrix(FMatrix::Identity)
+	, AreaToWorldMatrix(FMatrix::Identity)
+	, AreaRadiusScale(1.f)
+	, MinBox(FVector2D(-150.f), FVector2D(150.f))
 	, MaxBox(FVector2D(-300.f), FVector2D(300.f))
-#if WITH_EDITOR
+	, bHasVerticalExtent(false)
+	, VerticalExtent(0.f, 300.f)
+	, LevelErrorBudget(0.05f)
+#if WITH_EDITORONLY_DATA
 	, EditorSelectedColor(FLinearColor::Red)
 	, EditorUnselectedColor(FLinearColor::Green)
 	, EditorBoxColor(FLinearColor::Yellow)
 	, MinRadius(50.f)
+	, SimplifyMaxError(10.f)
 	, bDrawArea(true)
 	, bDrawBoxes(true)
-	, bDrawTestedSegments(true)
+	, bDrawQueryCostHeatmap(false)
+	, QueryHeatmapMargin(1000.f)
+	, QueryHeatmapResolution(48)
+	, QueryHeatmapMaxSides(16)
 #endif
 {
-	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
-	// off to improve performance if you don't need them.
+	// Tick only polls async rebuilds, so it is enabled while one is in flight
 	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 
 #if WITH_EDITOR
 	Points.Add(FVector2D(300.f, 0.f));
@@ -96,7 +146,48 @@ void UPolygonArea2DComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+	SFX_LLM_SCOPE();
+
 	ensure(Points.Num() > 3);
+
+	// Shape set up by InitializeShape before play is already complete
+	if (!Shape.IsValid())
+	{
+		ResetShape(true);
+	}
+
+	AreaSubsystem = GetWorld()->GetSubsystem<UPolygonAreaSubsystem>();
+	if (AreaSubsystem != nullptr)
+	{
+		ArenaHandle = AreaSubsystem->RegisterArea(this, Points, MinBox, MaxBox, GetVerticalExtent(), GetOwner()->GetActorTransform());
+	}
+
+	if (USceneComponent* OwnerRoot = GetOwner()->GetRootComponent())
+	{
+		OwnerRoot->TransformUpdated.AddUObject(this, &UPolygonArea2DComponent::OnOwnerTransformUpdated);
+	}
+	UpdateAreaTransform();
+}
+
+void UPolygonArea2DComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USceneComponent* OwnerRoot = GetOwner()->GetRootComponent())
+	{
+		OwnerRoot->TransformUpdated.RemoveAll(this);
+	}
+
+	if (AreaSubsystem != nullptr)
+	{
+		AreaSubsystem->UnregisterArea(ArenaHandle);
+		AreaSubsystem = nullptr;
+	}
+
+	// Unfinished rebuild results are just dropped by the worker
+	RebuildTask.Reset();
+	bHasQueuedPoints = false;
+	RequestedPoints.Empty();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 
@@ -105,77 +196,100 @@ void UPolygonArea2DComponent::TickComponent(float DeltaTime, ELevelTick TickType
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-#if WITH_EDITOR
+	if (RebuildTask.IsValid() && RebuildTask.IsReady())
 	{
-		using namespace Utils;
+		FPolygonAreaShapePtr NewShape = RebuildTask.Get();
+		RebuildTask.Reset();
 
-		FVector ActorLocation = GetOwner()->GetActorLocation();
+		PublishShape(NewShape);
 
-		if (bDrawBoxes)
+		if (bHasQueuedPoints)
 		{
-			DrawDebugBox(GetWorld(),
-				ActorLocation + To3D(MaxBox.GetCenter()),
-				FVector(MaxBox.GetExtent(), 200.f), FColor::Red,
-				false, -1., (uint8)1u, 5.f);
-
-			DrawDebugBox(GetWorld(),
-				ActorLocation + To3D(MinBox.GetCenter()),
-				FVector(MinBox.GetExtent(), 200.f), FColor::Green,
-				false, -1., (uint8)1u, 5.f);
+			StartRebuild();
 		}
-
-		if (bDrawArea)
+		else
 		{
-			FVector2D LastPoint = Points.Last();
-			for (const auto& Point : Points)
-			{
-				DrawDebugLine(GetWorld(),
-					ActorLocation + To3D(LastPoint),
-					ActorLocation + To3D(Point),
-					FColor::Yellow, false, -1., (uint8)1u, 5.f);
-
-				LastPoint = Point;
-			}
+			// Published shape has caught up with the requests
+			RequestedPoints.Empty();
 		}
 	}
-#endif
+
+	if (!RebuildTask.IsValid())
+	{
+		SetComponentTickEnabled(false);
+	}
 }
 
-bool UPolygonArea2DComponent::IsWithinRadius(const FVector& Location, float Radius)
+float UPolygonArea2DComponent::GetBoundsDistSquared(const FVector& Location) const
 {
 	using namespace Utils;
-	return FVector2D::DistSquared(MaxBox.GetClosestPointTo(As2D(Location)), As2D(Location)) <= Radius * Radius;
+
+	const float VerticalDist = Location.Z - ClampToVerticalExtent(Location.Z);
+	return FVector2D::DistSquared(MaxBox.GetClosestPointTo(As2D(Location)), As2D(Location)) + VerticalDist * VerticalDist;
 }
 
-FVector UPolygonArea2DComponent::FindClosestPoint(const FVector& Location)
+FVector UPolygonArea2DComponent::FindClosestPointImpl(const FVector& Location, float* OutSignedDistance)
+{
+	FNoQueryTrace Trace;
+	return FindClosestPointTraced(Location, OutSignedDistance, Trace);
+}
+
+template<typename TQueryTrace>
+FVector UPolygonArea2DComponent::FindClosestPointTraced(const FVector& Location, float* OutSignedDistance, TQueryTrace& Trace) const
 {
 	using namespace Utils;
 
 	const FVector2D &Loc2D = As2D(Location);
+	const float ClosestZ = ClampToVerticalExtent(Location.Z);
+	const float VerticalDist = Location.Z - ClosestZ;
+
+	// Location is inside in 2D: it's either above/below the area or inside at some depth
+	auto GetInsideSignedDistance = [this, &Location, &Loc2D, VerticalDist](TArrayView<const FVector2D> Polygon, int32 LeftIdx)
+	{
+		if (VerticalDist != 0.f) return FMath::Abs(VerticalDist);
+
+		float Depth = FindInsideDepth(Polygon, LeftIdx, Loc2D);
+		if (bHasVerticalExtent)
+		{
+			Depth = FMath::Min3(Depth, Location.Z - VerticalExtent.Min, VerticalExtent.Max - Location.Z);
+		}
+		return -Depth;
+	};
 
 	if (MinBox.IsInside(Loc2D))
 	{
+		if (OutSignedDistance != nullptr)
+		{
+			// No sector contains the origin, but the depth bound is zero there, so starting from any side checks all of them
+			const TArrayView<const FVector2D> FullPolygon = GetPoints();
+			const int32 LeftIdx = Loc2D.IsNearlyZero() ? 0 : FindContainingSector(FullPolygon, Loc2D);
+			*OutSignedDistance = GetInsideSignedDistance(FullPolygon, LeftIdx);
+		}
+
 		// Location is inside the MinBox inscribed in polygon
-		return Location;
+		return FVector(Loc2D, ClosestZ);
 	}
 
-	auto PointsC = GetCyclic(Points);
+	const TArrayView<const FVector2D> Polygon = TQueryTrace::bUseLevels ? GetLevelPoints(Loc2D) : GetPoints();
+	auto PointsC = GetCyclic(Polygon);
 
 	// Find line point indices of polygon sector containing the Loc2D
-	int32 LeftIdx = FindContainingSector(Loc2D);
+	int32 LeftIdx = FindContainingSector(Polygon, Loc2D);
 	int32 RightIdx = PointsC.Next(LeftIdx);
 
-	const FVector2D &LeftPoint = Points[LeftIdx];
-	const FVector2D &RightPoint = Points[RightIdx];
+	const FVector2D &LeftPoint = Polygon[LeftIdx];
+	const FVector2D &RightPoint = Polygon[RightIdx];
 
-#if WITH_EDITOR
-	DrawDebugSegment(LeftPoint, RightPoint);
-#endif
+	Trace.Sector(LeftPoint, RightPoint);
 
 	if (FMathExt::IsInsideTriangleLocal2D(LeftPoint, RightPoint, Loc2D))
 	{
 		// Location is inside triangle formed by the (LeftPoint, RightPoint) polygon side and origin
-		return Location;
+		if (OutSignedDistance != nullptr)
+		{
+			*OutSignedDistance = GetInsideSignedDistance(Polygon, LeftIdx);
+		}
+		return FVector(Loc2D, ClosestZ);
 	}
 
 	// Helper data struct for checking closest points to lines before LeftPoint and after RightPoint
@@ -199,17 +313,15 @@ FVector UPolygonArea2DComponent::FindClosestPoint(const FVector& Location)
 	float ClosestPointDistSqr = MAX_FLT;
 
 	// Function finds a better closest point on the next polygon line if applicable
-	auto FindClosestPoint = [this, &PointsC, &Loc2D, &ClosestPoint, &ClosestPointDistSqr](CheckDataType &Data)
+	auto FindClosestPoint = [&Trace, &Polygon, &PointsC, &Loc2D, &ClosestPoint, &ClosestPointDistSqr](CheckDataType &Data)
 	{
 		if (!Data.bCheckNext) return;
 
 		int32 NextIdx = (PointsC.*Data.GetNextIdx)(Data.Idx); // Get line end point index
-		const FVector2D &LineBegin = Points[Data.Idx];
-		const FVector2D &LineEnd = Points[NextIdx];
+		const FVector2D &LineBegin = Polygon[Data.Idx];
+		const FVector2D &LineEnd = Polygon[NextIdx];
 
-#if WITH_EDITOR
-		DrawDebugSide(LineBegin, LineEnd);
-#endif
+		Trace.Side(LineBegin, LineEnd);
 
 		FVector2D LineClosestPoint = FMath::ClosestPointOnSegment2D(Loc2D, LineBegin, LineEnd);
 		float LineClosestPointDistSqr = (LineClosestPoint - Loc2D).SizeSquared();
@@ -247,12 +359,550 @@ FVector UPolygonArea2DComponent::FindClosestPoint(const FVector& Location)
 		FindClosestPoint(CheckData[i]);
 	}
 
-	return FVector(ClosestPoint, Location.Z);
+	if (OutSignedDistance != nullptr)
+	{
+		*OutSignedDistance = FMath::Sqrt(ClosestPointDistSqr + VerticalDist * VerticalDist);
+	}
+
+	return FVector(ClosestPoint, ClosestZ);
+}
+
+float UPolygonArea2DComponent::FindInsideDepth(TArrayView<const FVector2D> Polygon, int32 LeftIdx, const FVector2D& Location)
+{
+	auto PointsC = Utils::GetCyclic(Polygon);
+
+	auto GetSideDistSqr = [&Location](const FVector2D& A, const FVector2D& B)
+	{
+		return FVector2D::DistSquared(FMath::ClosestPointOnSegment2D(Location, A, B), Location);
+	};
+
+	// Sides seen from the origin at angle Phi from the Location are at least |Location| * Sin(Phi) away (|Location| if Phi >= PI / 2)
+	// Angles only grow while walking away from the containing sector, so the bound at the next vertex holds for all further sides
+	const float LocationSizeSqr = Location.SizeSquared();
+	auto GetBoundSqr = [&Location, LocationSizeSqr](const FVector2D& Vertex)
+	{
+		return (Location | Vertex) > 0.f ? FMath::Square(Location ^ Vertex) / Vertex.SizeSquared() : LocationSizeSqr;
+	};
+
+	int32 RightIdx = PointsC.Next(LeftIdx);
+	float DepthSqr = GetSideDistSqr(Polygon[LeftIdx], Polygon[RightIdx]);
+
+	bool bCheckRight = true;
+	bool bCheckLeft = true;
+	for (int32 NumChecked = 1; (bCheckRight || bCheckLeft) && NumChecked < Polygon.Num(); )
+	{
+		if (bCheckRight)
+		{
+			bCheckRight = GetBoundSqr(Polygon[RightIdx]) < DepthSqr;
+			if (bCheckRight)
+			{
+				const int32 NextIdx = PointsC.Next(RightIdx);
+				DepthSqr = FMath::Min(DepthSqr, GetSideDistSqr(Polygon[RightIdx], Polygon[NextIdx]));
+				RightIdx = NextIdx;
+				NumChecked++;
+			}
+		}
+
+		if (bCheckLeft && NumChecked < Polygon.Num())
+		{
+			bCheckLeft = GetBoundSqr(Polygon[LeftIdx]) < DepthSqr;
+			if (bCheckLeft)
+			{
+				const int32 PrevIdx = PointsC.Prev(LeftIdx);
+				DepthSqr = FMath::Min(DepthSqr, GetSideDistSqr(Polygon[PrevIdx], Polygon[LeftIdx]));
+				LeftIdx = PrevIdx;
+				NumChecked++;
+			}
+		}
+	}
+
+	return FMath::Sqrt(DepthSqr);
+}
+
+bool UPolygonArea2DComponent::IsInside(const FVector& Location) const
+{
+	using namespace Utils;
+
+	if (Location.Z != ClampToVerticalExtent(Location.Z)) return false;
+
+	return IsInside2D(GetPoints(), As2D(Location));
+}
+
+bool UPolygonArea2DComponent::IsInside2D(TArrayView<const FVector2D> Polygon, const FVector2D& Location) const
+{
+	if (MinBox.IsInside(Location)) return true;
+	if (!MaxBox.IsInside(Location)) return false;
+
+	// Same sector and triangle test FindClosestPoint starts with
+	const int32 LeftIdx = FindContainingSector(Polygon, Location);
+	const int32 RightIdx = Utils::GetCyclic(Polygon).Next(LeftIdx);
+
+	return FMathExt::IsInsideTriangleLocal2D(Polygon[LeftIdx], Polygon[RightIdx], Location);
+}
+
+float UPolygonArea2DComponent::FindAngularExtent(const FVector& Location) const
+{
+	using namespace Utils;
+
+	const FVector2D& Loc2D = As2D(Location);
+	if (MinBox.IsInside(Loc2D)) return 2.f * PI;
+
+	const FPolygonAreaLevel* Level = FindLevel(Loc2D);
+	const TArrayView<const FVector2D> Polygon = Level != nullptr ? TArrayView<const FVector2D>(Level->Points) : GetPoints();
+	const TArrayView<const FVector2D> Hull = Level != nullptr ? TArrayView<const FVector2D>(Level->Hull) : Shape.IsValid() ? TArrayView<const FVector2D>(Shape->Hull) : TArrayView<const FVector2D>();
+
+	// Seen from outside of the convex hull, the polygon spans the same angle as its hull
+	if (Hull.Num() > 2)
+	{
+		auto HullC = GetCyclic(Hull);
+		auto IsSideVisible = [Hull, HullC, &Loc2D](int32 Idx)
+		{
+			const FVector2D& Start = Hull[HullC.Wrap(Idx)];
+			const FVector2D& End = Hull[HullC.Wrap(Idx + 1)];
+			return ((End - Start) ^ (Loc2D - Start)) < 0.f;
+		};
+
+		// Side crossed by the ray from the origin through the Location faces it, the side behind the origin faces away
+		const int32 VisibleIdx = FindContainingSector(Hull, Loc2D);
+		const int32 HiddenIdx = FindContainingSector(Hull, -Loc2D);
+
+		// Otherwise the Location is within the hull, so it may be in a concavity, which spans more
+		if (IsSideVisible(VisibleIdx) && !IsSideVisible(HiddenIdx))
+		{
+			// Visible sides form one run, which ends somewhere between the two sides on either way around the hull
+			const int32 NumToHidden = HullC.Wrap(HiddenIdx - VisibleIdx);
+
+			int32 LastVisible = 0;
+			int32 FirstHidden = NumToHidden;
+			while (FirstHidden - LastVisible > 1)
+			{
+				const int32 Mid = (LastVisible + FirstHidden) / 2;
+				if (IsSideVisible(VisibleIdx + Mid))
+				{
+					LastVisible = Mid;
+				}
+				else
+				{
+					FirstHidden = Mid;
+				}
+			}
+
+			int32 LastHidden = 0;
+			int32 FirstVisible = Hull.Num() - NumToHidden;
+			while (FirstVisible - LastHidden > 1)
+			{
+				const int32 Mid = (LastHidden + FirstVisible) / 2;
+				if (IsSideVisible(HiddenIdx + Mid))
+				{
+					FirstVisible = Mid;
+				}
+				else
+				{
+					LastHidden = Mid;
+				}
+			}
+
+			// Tangent points are the end of the last visible side and the start of the first one
+			const FVector2D RightDir = Hull[HullC.Wrap(VisibleIdx + LastVisible + 1)] - Loc2D;
+			const FVector2D LeftDir = Hull[HullC.Wrap(HiddenIdx + FirstVisible)] - Loc2D;
+
+			return FMath::Atan2(FMath::Abs(RightDir ^ LeftDir), RightDir | LeftDir);
+		}
+	}
+
+	auto PointsC = GetCyclic(Polygon);
+
+	const int32 LeftIdx = FindContainingSector(Polygon, Loc2D);
+	if (FMathExt::IsInsideTriangleLocal2D(Polygon[LeftIdx], Polygon[PointsC.Next(LeftIdx)], Loc2D)) return 2.f * PI;
+
+	// Seen from outside, the direction turns by less than PI along every side and the turns sum up to zero,
+	// so the accumulated turn range is the spanned angle, even if the polygon wraps around the Location
+	// Walk starts from the containing sector side, which faces the Location
+	float Angle = 0.f;
+	float MinAngle = 0.f;
+	float MaxAngle = 0.f;
+
+	FVector2D LastDir = Polygon[LeftIdx] - Loc2D;
+	for (int32 Idx = PointsC.Next(LeftIdx), NumVisited = 0; NumVisited < Polygon.Num(); Idx = PointsC.Next(Idx), NumVisited++)
+	{
+		const FVector2D Dir = Polygon[Idx] - Loc2D;
+		Angle += FMath::Atan2(LastDir ^ Dir, LastDir | Dir);
+
+		MinAngle = FMath::Min(MinAngle, Angle);
+		MaxAngle = FMath::Max(MaxAngle, Angle);
+		LastDir = Dir;
+	}
+
+	return FMath::Min(MaxAngle - MinAngle, 2.f * PI);
+}
+
+void UPolygonArea2DComponent::FindSegmentCrossings(TArrayView<const FVector> Starts, TArrayView<const FVector> Ends, TArray<FPolygonAreaCrossing>& OutCrossings) const
+{
+	check(Starts.Num() == Ends.Num());
+
+	for (int32 Index = 0; Index < Starts.Num(); Index++)
+	{
+		AddSegmentCrossings(Index, Starts[Index], Ends[Index], OutCrossings);
+	}
+}
+
+bool UPolygonArea2DComponent::RaycastBoundary(const FVector& Origin, const FVector& Direction, FPolygonAreaCrossing& OutCrossing) const
+{
+	// Ray is cut where it leaves the bounds, so it becomes a segment (infinitely tall areas are not bounded along Z)
+	const FBox Bounds(FVector(MaxBox.Min, VerticalExtent.Min), FVector(MaxBox.Max, VerticalExtent.Max));
+	const int32 NumAxes = bHasVerticalExtent ? 3 : 2;
+
+	float EnterTime = 0.f;
+	float ExitTime = MAX_FLT;
+	for (int32 Axis = 0; Axis < NumAxes; Axis++)
+	{
+		if (Direction[Axis] == 0.f)
+		{
+			if (Origin[Axis] < Bounds.Min[Axis] || Origin[Axis] > Bounds.Max[Axis]) return false;
+			continue;
+		}
+
+		const float Time1 = (Bounds.Min[Axis] - Origin[Axis]) / Direction[Axis];
+		const float Time2 = (Bounds.Max[Axis] - Origin[Axis]) / Direction[Axis];
+		EnterTime = FMath::Max(EnterTime, FMath::Min(Time1, Time2));
+		ExitTime = FMath::Min(ExitTime, FMath::Max(Time1, Time2));
+	}
+
+	if (ExitTime < EnterTime || ExitTime == MAX_FLT) return false;
+
+	// Boundary may touch the bounds, so the segment goes a bit past them
+	const float SegmentTime = ExitTime * 1.001f;
+
+	TArray<FPolygonAreaCrossing, TInlineAllocator<8>> Crossings;
+	AddSegmentCrossings(0, Origin, Origin + Direction * SegmentTime, Crossings);
+	if (Crossings.Num() == 0) return false;
+
+	OutCrossing = Crossings[0];
+	OutCrossing.Time *= SegmentTime;
+	return true;
+}
+
+template<typename AllocatorType>
+void UPolygonArea2DComponent::AddSegmentCrossings(int32 SegmentIndex, const FVector& Start, const FVector& End, TArray<FPolygonAreaCrossing, AllocatorType>& OutCrossings) const
+{
+	using namespace Utils;
+
+	const int32 FirstCrossing = OutCrossings.Num();
+	const TArrayView<const FVector2D> Polygon = GetPoints();
+
+	const FVector2D& Start2D = As2D(Start);
+	const FVector2D& End2D = As2D(End);
+	const FVector2D Dir2D = End2D - Start2D;
+	const FVector Dir = End - Start;
+
+	auto AddCrossing = [&](float Time, int32 SideIndex, bool bEntering)
+	{
+		OutCrossings.Add({ SegmentIndex, Time, Start + Dir * Time, SideIndex, bEntering });
+	};
+
+	// Bottom and top of the vertical extent are crossed where the crossing point is inside the polygon
+	if (bHasVerticalExtent && Dir.Z != 0.f)
+	{
+		for (const float CapZ : { VerticalExtent.Min, VerticalExtent.Max })
+		{
+			const float Time = (CapZ - Start.Z) / Dir.Z;
+			if (Time >= 0.f && Time <= 1.f && IsInside2D(Polygon, Start2D + Dir2D * Time))
+			{
+				AddCrossing(Time, INDEX_NONE, (CapZ == VerticalExtent.Min) == (Dir.Z > 0.f));
+			}
+		}
+	}
+
+	// Segments inside the inscribed box or not touching the bounding box cross no sides
+	const bool bInsideMinBox = MinBox.IsInside(Start2D) && MinBox.IsInside(End2D);
+	const bool bOutsideMaxBox =
+		(Start2D.X < MaxBox.Min.X && End2D.X < MaxBox.Min.X) || (Start2D.X > MaxBox.Max.X && End2D.X > MaxBox.Max.X) ||
+		(Start2D.Y < MaxBox.Min.Y && End2D.Y < MaxBox.Min.Y) || (Start2D.Y > MaxBox.Max.Y && End2D.Y > MaxBox.Max.Y);
+
+	if (!bInsideMinBox && !bOutsideMaxBox && !Dir2D.IsNearlyZero())
+	{
+		auto PointsC = GetCyclic(Polygon);
+
+		// A side is crossed at most once, sides meeting at a crossed vertex are told apart by the half-open side parameter
+		auto TestSide = [&](int32 SideIdx)
+		{
+			const FVector2D& SideBegin = Polygon[SideIdx];
+			const FVector2D SideDir = Polygon[PointsC.Next(SideIdx)] - SideBegin;
+
+			const float Denom = Dir2D ^ SideDir;
+			if (FMath::IsNearlyZero(Denom)) return;
+
+			const FVector2D ToSide = SideBegin - Start2D;
+			const float Time = (ToSide ^ SideDir) / Denom;
+			const float SideTime = (ToSide ^ Dir2D) / Denom;
+			if (Time < 0.f || Time > 1.f || SideTime < 0.f || SideTime >= 1.f) return;
+
+			// Vertical extent limits the sides as well
+			const float Z = Start.Z + Dir.Z * Time;
+			if (Z != ClampToVerticalExtent(Z)) return;
+
+			// Polygon goes counterclockwise, so the inside is to the left from every side
+			AddCrossing(Time, SideIdx, (SideDir ^ Dir2D) > 0.f);
+		};
+
+		const float Sweep = Start2D ^ End2D;
+		const bool bStartAtOrigin = Start2D.IsNearlyZero();
+		const bool bEndAtOrigin = End2D.IsNearlyZero();
+
+		if (bStartAtOrigin || bEndAtOrigin || FMath::IsNearlyZero(Sweep))
+		{
+			// Segment lies on a line through the origin, so it only meets the sectors of its ends
+			const int32 StartSector = bStartAtOrigin ? INDEX_NONE : FindContainingSector(Polygon, Start2D);
+			const int32 EndSector = bEndAtOrigin ? INDEX_NONE : FindContainingSector(Polygon, End2D);
+
+			if (StartSector != INDEX_NONE) TestSide(StartSector);
+			if (EndSector != INDEX_NONE && EndSector != StartSector) TestSide(EndSector);
+		}
+		else
+		{
+			// Angle seen from the origin changes monotonically along the segment (by less than PI),
+			// so walking the sectors from the start to the end one visits the crossings in order
+			const int32 EndSector = FindContainingSector(Polygon, End2D);
+			int32 SideIdx = FindContainingSector(Polygon, Start2D);
+
+			for (int32 NumVisited = 0; NumVisited < Polygon.Num(); NumVisited++)
+			{
+				TestSide(SideIdx);
+				if (SideIdx == EndSector) break;
+
+				SideIdx = Sweep > 0.f ? PointsC.Next(SideIdx) : PointsC.Prev(SideIdx);
+			}
+		}
+	}
+
+	const int32 NumCrossings = OutCrossings.Num() - FirstCrossing;
+	if (NumCrossings > 1)
+	{
+		Algo::SortBy(MakeArrayView(OutCrossings.GetData() + FirstCrossing, NumCrossings), &FPolygonAreaCrossing::Time);
+	}
+}
+
+void UPolygonArea2DComponent::InitializeShape(const TArray<FVector2D>& InPoints, const FBox2D& InMinBox, const FBox2D& InMaxBox, bool bBuildLevels)
+{
+	// Explicit polygon replaces any pending request
+	RebuildTask.Reset();
+	bHasQueuedPoints = false;
+	RequestedPoints.Empty();
+
+	Points = InPoints;
+	MinBox = InMinBox;
+	MaxBox = InMaxBox;
+
+	ResetShape(false, bBuildLevels);
+}
+
+void UPolygonArea2DComponent::SetVerticalExtent(const FFloatInterval& NewVerticalExtent)
+{
+	bHasVerticalExtent = NewVerticalExtent.IsValid();
+	if (bHasVerticalExtent)
+	{
+		VerticalExtent = NewVerticalExtent;
+	}
+
+	if (AreaSubsystem != nullptr && ArenaHandle.IsValid())
+	{
+		AreaSubsystem->GetArena().SetVerticalExtent(ArenaHandle, GetVerticalExtent(), GetOwner()->GetActorTransform());
+	}
+
+	OnVerticalExtentChanged.Broadcast(this);
+}
+
+void UPolygonArea2DComponent::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	// Snapshots may be shared with readers for a while, but the component is the one keeping them alive
+	if (Shape.IsValid())
+	{
+		CumulativeResourceSize.AddDedicatedSystemMemoryBytes(sizeof(FPolygonAreaShape) + Shape->GetAllocatedSize());
+	}
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(RequestedPoints.GetAllocatedSize());
+
+	if (AreaSubsystem != nullptr && ArenaHandle.IsValid())
+	{
+		CumulativeResourceSize.AddDedicatedSystemMemoryBytes(GetPoints().Num() * sizeof(FVector2D) + sizeof(FPolygonAreaBounds));
+	}
+}
+
+void UPolygonArea2DComponent::ResetShape(bool bAllowAsync, bool bBuildLevels)
+{
+	SFX_LLM_SCOPE();
+
+	// Points set before BeginPlay are newer than the serialized ones, so their rebuild is finished instead of started over
+	if (RebuildTask.IsValid())
+	{
+		FPolygonAreaShapePtr PendingShape = RebuildTask.Get();
+		RebuildTask.Reset();
+
+		if (PendingShape.IsValid())
+		{
+			PublishShape(PendingShape);
+			if (bHasQueuedPoints)
+			{
+				StartRebuild();
+			}
+			return;
+		}
+	}
+
+	// Serialized bounds are trusted, no need to rebuild them
+	TSharedRef<FPolygonAreaShape, ESPMode::ThreadSafe> InitialShape = MakeShared<FPolygonAreaShape, ESPMode::ThreadSafe>();
+	InitialShape->Points = Points;
+	InitialShape->MinBox = MinBox;
+	InitialShape->MaxBox = MaxBox;
+
+	// Large pyramids are built the same way as runtime changes, queries use the original polygon meanwhile
+	if (bAllowAsync && Points.Num() >= MinPointsForAsyncRebuild)
+	{
+		RequestedPoints = Points;
+		bHasQueuedPoints = true;
+		StartRebuild();
+	}
+	else if (bBuildLevels)
+	{
+		InitialShape->BuildLevels();
+	}
+
+	Shape = InitialShape;
+}
+
+void UPolygonArea2DComponent::SetPoints(const TArray<FVector2D>& NewPoints)
+{
+	SFX_LLM_SCOPE();
+
+	RequestedPoints = NewPoints;
+	bHasQueuedPoints = true;
+
+	if (NewPoints.Num() < MinPointsForAsyncRebuild)
+	{
+		// Stale async result would override this one, so let it finish first
+		if (!RebuildTask.IsValid())
+		{
+			bHasQueuedPoints = false;
+			PublishShape(FPolygonAreaShape::Build(RequestedPoints));
+			RequestedPoints.Empty();
+		}
+		return;
+	}
+
+	if (!RebuildTask.IsValid())
+	{
+		StartRebuild();
+	}
+}
+
+void UPolygonArea2DComponent::DeformPoints(const TArray<FVector2D>& Offsets)
+{
+	// Deform the latest requested polygon, so consecutive deformations accumulate even while it is being built
+	TArray<FVector2D> NewPoints = HasPendingPoints() ? RequestedPoints : Points;
+	if (!ensureMsgf(Offsets.Num() == NewPoints.Num(), TEXT("DeformPoints expects an offset for every polygon point"))) return;
+
+	for (int32 Index = 0; Index < NewPoints.Num(); Index++)
+	{
+		NewPoints[Index] += Offsets[Index];
+	}
+
+	SetPoints(NewPoints);
+}
+
+void UPolygonArea2DComponent::StartRebuild()
+{
+	check(!RebuildTask.IsValid());
+
+	bHasQueuedPoints = false;
+	SetComponentTickEnabled(true);
+	RebuildTask = Async(EAsyncExecution::ThreadPool, [BuildPoints = RequestedPoints]() mutable
+	{
+		return FPolygonAreaShape::Build(MoveTemp(BuildPoints));
+	});
+}
+
+void UPolygonArea2DComponent::PublishShape(FPolygonAreaShapePtr NewShape)
+{
+	check(IsInGameThread());
+	if (!ensureMsgf(NewShape.IsValid(), TEXT("%s: runtime polygon is not star-shaped, keeping the previous one"), *GetPathName())) return;
+
+	// Readers holding the previous snapshot keep it alive until they are done
+	Shape = NewShape;
+
+	Points = Shape->Points;
+	MinBox = Shape->MinBox;
+	MaxBox = Shape->MaxBox;
+
+	if (AreaSubsystem != nullptr && ArenaHandle.IsValid())
+	{
+		AreaSubsystem->UpdateArea(ArenaHandle, Points, MinBox, MaxBox, GetVerticalExtent(), GetOwner()->GetActorTransform());
+	}
+}
+
+void UPolygonArea2DComponent::OnOwnerTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	UpdateAreaTransform();
 }
 
-int32 UPolygonArea2DComponent::FindContainingSector(const FVector2D& Location)
+void UPolygonArea2DComponent::UpdateAreaTransform()
 {
-	check(Points.Num() > 2);
+	const FTransform& ActorTransform = GetOwner()->GetActorTransform();
+
+	AreaToWorldMatrix = ActorTransform.ToMatrixWithScale();
+	WorldToAreaMatrix = AreaToWorldMatrix.Inverse();
+
+	// Area space distances are at most 1/MinScale times longer than world ones, so the scaled radius never culls audible listeners
+	const FVector Scale = ActorTransform.GetScale3D().GetAbs();
+	AreaRadiusScale = 1.f / FMath::Max(FMath::Min(Scale.X, Scale.Y), KINDA_SMALL_NUMBER);
+
+	if (AreaSubsystem != nullptr && ArenaHandle.IsValid())
+	{
+		AreaSubsystem->GetArena().SetTransform(ArenaHandle, ActorTransform);
+	}
+}
+
+TArrayView<const FVector2D> UPolygonArea2DComponent::GetPoints() const
+{
+	// Registered areas are queried from the packed arena, not from their own allocation
+	if (AreaSubsystem != nullptr && ArenaHandle.IsValid())
+	{
+		return AreaSubsystem->GetArena().GetPoints(ArenaHandle);
+	}
+
+	return Points;
+}
+
+const FPolygonAreaLevel* UPolygonArea2DComponent::FindLevel(const FVector2D& Location) const
+{
+	if (Shape.IsValid() && Shape->Levels.Num() > 0 && LevelErrorBudget > 0.f)
+	{
+		const float DistSqr = FVector2D::DistSquared(MaxBox.GetClosestPointTo(Location), Location);
+		const float MaxErrorSqr = DistSqr * LevelErrorBudget * LevelErrorBudget;
+
+		// Levels go from the finest to the coarsest
+		for (int32 Level = Shape->Levels.Num() - 1; Level >= 0; Level--)
+		{
+			const FPolygonAreaLevel& PolygonLevel = Shape->Levels[Level];
+			if (PolygonLevel.MaxError * PolygonLevel.MaxError <= MaxErrorSqr)
+			{
+				return &PolygonLevel;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+TArrayView<const FVector2D> UPolygonArea2DComponent::GetLevelPoints(const FVector2D& Location) const
+{
+	const FPolygonAreaLevel* Level = FindLevel(Location);
+	return Level != nullptr ? TArrayView<const FVector2D>(Level->Points) : GetPoints();
+}
+
+int32 UPolygonArea2DComponent::FindContainingSector(TArrayView<const FVector2D> Polygon, const FVector2D& Location)
+{
+	check(Polygon.Num() > 2);
 
 	// Predicates return if a point is in the left/right half-plane relative to the vector from the origin to the Location
 	auto IsLeft = [Location](const FVector2D& Point) { return (Point ^ Location) >= 0.f; };
@@ -260,21 +910,21 @@ int32 UPolygonArea2DComponent::FindContainingSector(const FVector2D& Location)
 
 	int32 AnyLeftIndex;
 	int32 AnyRightIndex;
-	bool LastIsRight = IsRight(Points.Last());
+	bool LastIsRight = IsRight(Polygon.Last());
 	if (LastIsRight) // Left points form one continuous sequence in the points array
 	{
-		AnyLeftIndex = FindAnyPoint(Points, IsLeft);
-		AnyRightIndex = Points.Num() - 1;
+		AnyLeftIndex = FindAnyPoint(Polygon, IsLeft);
+		AnyRightIndex = Polygon.Num() - 1;
 
 		checkf(AnyLeftIndex != INDEX_NONE, TEXT("Points array is invalid: all points are to the right from the point"));
 	}
 	else // Right points form one continuous sequence in the points array
 	{
-		bool FirstIsLeft = IsLeft(Points[0]);
+		bool FirstIsLeft = IsLeft(Polygon[0]);
 		if (FirstIsLeft)
 		{
 			AnyLeftIndex = 0;
-			AnyRightIndex = FindAnyPoint(Points, IsRight);
+			AnyRightIndex = FindAnyPoint(Polygon, IsRight);
 
 			checkf(AnyRightIndex != INDEX_NONE, TEXT("Points array is invalid: all points are to the left from the point"));
 		}
@@ -282,52 +932,121 @@ int32 UPolygonArea2DComponent::FindContainingSector(const FVector2D& Location)
 		{
 			// The last point is in the left half-plane, the first point is in the right,
 			// so the last and the first points form the containing sector
-			return Points.Num() - 1;
+			return Polygon.Num() - 1;
 		}
 	}
 
 	// AnyLeftIndex belongs to IsLeft continuous point sequences
 	// AnyRightIndex belongs to IsRight continuous point sequences
 	// Those two point sequences are adjacent, so the searched sector is the partition point between them
-	auto BeginIt = Points.GetData();
+	auto BeginIt = Polygon.GetData();
 	auto PartitionIt = std::partition_point(BeginIt + AnyLeftIndex, BeginIt + AnyRightIndex, IsLeft);
 	return (PartitionIt - BeginIt) - 1;
 }
 
-#if WITH_EDITOR
-void UPolygonArea2DComponent::DrawDebugSegment(const FVector2D& A, const FVector2D& B)
+#if ENABLE_DRAW_DEBUG
+void UPolygonArea2DComponent::AddDebugLines(TArray<FBatchedLine>& Lines, bool bOutline, bool bBoxes) const
 {
-	using namespace Utils;
+#if WITH_EDITOR
+	bOutline &= bDrawArea;
+	bBoxes &= bDrawBoxes;
+#endif
+
+	// Infinitely tall areas are drawn with a fixed height
+	const FFloatInterval DrawExtent = bHasVerticalExtent ? VerticalExtent : FFloatInterval(-200.f, 200.f);
 
-	if (bDrawTestedSegments)
+	if (bBoxes)
 	{
-		FVector ActorLocation = GetOwner()->GetActorLocation();
+		Utils::DebugDraw::AddBox(Lines, AreaToWorldMatrix,
+			FBox(FVector(MaxBox.Min, DrawExtent.Min), FVector(MaxBox.Max, DrawExtent.Max)), FLinearColor::Red, 5.f);
+		Utils::DebugDraw::AddBox(Lines, AreaToWorldMatrix,
+			FBox(FVector(MinBox.Min, DrawExtent.Min), FVector(MinBox.Max, DrawExtent.Max)), FLinearColor::Green, 5.f);
+	}
 
-		DrawDebugLine(GetWorld(),
-			ActorLocation, ActorLocation + To3D(A),
-			FColor::Cyan, false, -1., (uint8)1u, 10.f);
+	if (bOutline)
+	{
+		const float DrawZ = bHasVerticalExtent ? VerticalExtent.Min : 0.f;
 
-		DrawDebugLine(GetWorld(),
-			ActorLocation + To3D(A), ActorLocation + To3D(B),
-			FColor::Cyan, false, -1., (uint8)1u, 10.f);
+		FVector LastPoint = AreaToWorld(FVector(Points.Last(), DrawZ));
+		for (const FVector2D& Point : Points)
+		{
+			const FVector WorldPoint = AreaToWorld(FVector(Point, DrawZ));
+			Utils::DebugDraw::AddLine(Lines, LastPoint, WorldPoint, FLinearColor::Yellow, 5.f);
+			LastPoint = WorldPoint;
+		}
+	}
+}
+#endif
 
-		DrawDebugLine(GetWorld(),
-			ActorLocation + To3D(B), ActorLocation,
-			FColor::Cyan, false, -1., (uint8)1u, 10.f);
+#if WITH_EDITOR
+void UPolygonArea2DComponent::SimplifyPolygon()
+{
+	FPolygonAreaShapePtr OldShape = FPolygonAreaShape::Build(Points);
+	if (!OldShape.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: polygon is not star-shaped around the origin, fix it before simplifying"), *GetPathName());
+		return;
+	}
+
+	// Visualiser never lets the polygon go below 4 points either
+	TArray<FVector2D> SimplifiedPoints;
+	const float MaxError = Utils::PolygonSimplification::Simplify(Points, 4, SimplifyMaxError, MinRadius, SimplifiedPoints);
+
+	if (SimplifiedPoints.Num() == Points.Num())
+	{
+		UE_LOG(LogTemp, Display, TEXT("%s: no points can be removed within %.2f error"), *GetPathName(), SimplifyMaxError);
+		return;
 	}
+
+	FPolygonAreaShapePtr NewShape = FPolygonAreaShape::Build(MoveTemp(SimplifiedPoints));
+	if (!ensure(NewShape.IsValid())) return;
+
+	const double OldQuerySeconds = MeasureQuerySeconds(*OldShape);
+	const double NewQuerySeconds = MeasureQuerySeconds(*NewShape);
+
+	Modify();
+	Points = NewShape->Points;
+	MinBox = NewShape->MinBox;
+	MaxBox = NewShape->MaxBox;
+
+	UE_LOG(LogTemp, Display, TEXT("%s: simplified %d -> %d points (%.1f%% fewer, max error %.2f), closest point query %.3f -> %.3f us (%.1f%% faster)"),
+		*GetPathName(), OldShape->Points.Num(), Points.Num(), 100.f * (1.f - static_cast<float>(Points.Num()) / OldShape->Points.Num()), MaxError,
+		OldQuerySeconds * 1000000.0, NewQuerySeconds * 1000000.0, OldQuerySeconds > 0.0 ? 100.0 * (1.0 - NewQuerySeconds / OldQuerySeconds) : 0.0);
 }
 
-void UPolygonArea2DComponent::DrawDebugSide(const FVector2D& A, const FVector2D& B)
+double UPolygonArea2DComponent::MeasureQuerySeconds(const FPolygonAreaShape& MeasuredShape)
 {
-	using namespace Utils;
+	constexpr int32 NumQueries = 10000;
+
+	UPolygonArea2DComponent* Area = NewObject<UPolygonArea2DComponent>(GetTransientPackage());
+	Area->LevelErrorBudget = 0.f;
+	Area->InitializeShape(MeasuredShape.Points, MeasuredShape.MinBox, MeasuredShape.MaxBox);
+
+	// Same locations for every measured shape, mostly outside the polygon like real listeners
+	FRandomStream Random(NumQueries);
+	const FBox2D QueryBox = MeasuredShape.MaxBox.ExpandBy(MeasuredShape.MaxBox.GetExtent().GetMax());
 
-	if (bDrawTestedSegments)
+	TArray<FVector> Locations;
+	Locations.Reserve(NumQueries);
+	for (int32 i = 0; i < NumQueries; i++)
 	{
-		FVector ActorLocation = GetOwner()->GetActorLocation();
+		Locations.Add(FVector(Random.FRandRange(QueryBox.Min.X, QueryBox.Max.X), Random.FRandRange(QueryBox.Min.Y, QueryBox.Max.Y), 0.f));
+	}
 
-		DrawDebugLine(GetWorld(),
-			ActorLocation + To3D(A), ActorLocation + To3D(B),
-			FColor::Green, false, -1., (uint8)1u, 30.f);
+	const double StartTime = FPlatformTime::Seconds();
+	for (const FVector& Location : Locations)
+	{
+		Area->FindClosestPoint(Location);
 	}
+
+	return (FPlatformTime::Seconds() - StartTime) / NumQueries;
+}
+
+FPolygonAreaQueryStats UPolygonArea2DComponent::MeasureQueryCost(const FVector& Location) const
+{
+	FQueryCostTrace Trace;
+	FindClosestPointTraced(Location, nullptr, Trace);
+
+	return Trace.Stats;
 }
 #endif
\ No newline at end of file
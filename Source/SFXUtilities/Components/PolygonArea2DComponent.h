@@ -4,10 +4,41 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Components/SceneComponent.h"
 #include "Math/Box.h"
 
+#include "SFXUtilities/Utilities/PolygonAreaArena.h"
+#include "SFXUtilities/Utilities/PolygonAreaShape.h"
+
+#include "Async/Future.h"
+
 #include "PolygonArea2DComponent.generated.h"
 
+class UPolygonAreaSubsystem;
+class UPolygonArea2DComponent;
+struct FBatchedLine;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPolygonAreaVerticalExtentChanged, UPolygonArea2DComponent*);
+
+/** Crossing of a segment with the area boundary */
+struct FPolygonAreaCrossing
+{
+	int32 SegmentIndex; // Index of the segment in the batch
+	float Time; // Fraction of the segment from its start to the crossing (distance in Direction lengths for rays)
+	FVector Location; // Area space crossing point
+	int32 SideIndex; // Index of the first point of the crossed polygon side, INDEX_NONE for the bottom and top of the vertical extent
+	bool bEntering; // Is the segment going into the area at the crossing
+};
+
+#if WITH_EDITOR
+/** Work done by one closest point query, counted for the query cost heatmap */
+struct FPolygonAreaQueryStats
+{
+	bool bSectorTested = false; // Query got past the MinBox early-out to the containing sector triangle test
+	int32 NumSidesVisited = 0; // Sides walked after the location turned out to be outside the triangle
+};
+#endif
+
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class SFXUTILITIES_API UPolygonArea2DComponent : public UActorComponent
 {
@@ -21,22 +52,190 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
+	// Called when the game ends or the area streams out
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:	
 	// Called every frame
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
-	/** Returns true if the Location is within Radius from the MaxBox bounding box in 2D */
-	bool IsWithinRadius(const FVector& Location, float Radius);
+	// Begin UObject interface
+	/** Adds the published shape with its pyramid, the queued points and the share of the area arena */
+	void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+	// End UObject interface
+
+	/** Transforms the world space Location to the area space, where the polygon is defined */
+	FVector WorldToArea(const FVector& Location) const { return WorldToAreaMatrix.TransformPosition(Location); }
+
+	/** Transforms the area space Location back to the world space */
+	FVector AreaToWorld(const FVector& Location) const { return AreaToWorldMatrix.TransformPosition(Location); }
+
+	/** Converts the world space Radius to the conservative area space radius (accounts for non-uniform scale) */
+	float WorldToAreaRadius(float Radius) const { return Radius * AreaRadiusScale; }
+
+	/** Converts the area space Distance back to the world space (exact for uniform scale) */
+	float AreaToWorldDistance(float Distance) const { return Distance / AreaRadiusScale; }
+
+	/** Returns true if the Location is within Radius from the MaxBox bounding box extruded over the vertical extent */
+	bool IsWithinRadius(const FVector& Location, float Radius) const { return GetBoundsDistSquared(Location) <= Radius * Radius; }
+
+	/** Returns squared distance from the Location to the MaxBox bounding box extruded over the vertical extent, so one check serves several radii */
+	float GetBoundsDistSquared(const FVector& Location) const;
+
+	/** Returns the closest to the Location point inside the polygon extruded over the vertical extent */
+	FVector FindClosestPoint(const FVector &Location) { return FindClosestPointImpl(Location, nullptr); }
+
+	/**
+	 * Same as FindClosestPoint, also returns the signed distance to the boundary in the same pass:
+	 * distance to the closest point if the Location is outside, minus the distance to the nearest side (depth) if inside
+	 */
+	FVector FindClosestPoint(const FVector &Location, float& OutSignedDistance) { return FindClosestPointImpl(Location, &OutSignedDistance); }
+
+	/** Returns true if the area space Location is inside the polygon extruded over the vertical extent */
+	bool IsInside(const FVector& Location) const;
+
+	/**
+	 * Returns the angle (radians) the polygon spans as seen from the area space Location, 2 PI if the Location is inside in 2D
+	 * Uses the same pyramid level as FindClosestPoint, so the error stays within about LevelErrorBudget radians (exact for uniform scale)
+	 * Locations outside the convex hull of the level take two binary searches, locations within its concavities walk every side
+	 */
+	float FindAngularExtent(const FVector& Location) const;
+
+	/**
+	 * Collects crossings of the area space segments (Starts[i], Ends[i]) with the area boundary: polygon sides and the bottom and top of the vertical extent
+	 * Only the sides of the sectors swept by a segment as seen from the origin are tested, the first one is found by the binary search
+	 * OutCrossings go in the order of the segments, crossings of one segment in the order along it
+	 */
+	void FindSegmentCrossings(TArrayView<const FVector> Starts, TArrayView<const FVector> Ends, TArray<FPolygonAreaCrossing>& OutCrossings) const;
+
+	/** Single segment version of FindSegmentCrossings */
+	void FindSegmentCrossings(const FVector& Start, const FVector& End, TArray<FPolygonAreaCrossing>& OutCrossings) const { FindSegmentCrossings(MakeArrayView(&Start, 1), MakeArrayView(&End, 1), OutCrossings); }
+
+	/** Returns true if the area space ray crosses the area boundary, OutCrossing is the first crossing */
+	bool RaycastBoundary(const FVector& Origin, const FVector& Direction, FPolygonAreaCrossing& OutCrossing) const;
+
+	/**
+	 * Replaces the polygon at runtime (NewPoints must form a star-shaped polygon around the origin)
+	 * Large polygons are rebuilt on a worker thread, queries keep using the previous polygon until the new one is published
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Area")
+	void SetPoints(const TArray<FVector2D>& NewPoints);
+
+	/** Offsets every polygon point by the corresponding Offsets element and rebuilds the polygon like SetPoints does */
+	UFUNCTION(BlueprintCallable, Category = "Area")
+	void DeformPoints(const TArray<FVector2D>& Offsets);
 
-	/** Returns the closest to the Location point inside the polygon in 2D (Z is copied from the Location) */
-	FVector FindClosestPoint(const FVector &Location);
+	/** Returns the published polygon snapshot, must be called on the game thread (which publishes them), the snapshot may then be kept and read from any thread */
+	FPolygonAreaShapePtr GetShape() const { check(IsInGameThread()); return Shape; }
+
+	/**
+	 * Sets the polygon with precomputed bounds and synchronously builds its acceleration data (for tools and tests, before BeginPlay or without a world)
+	 * Without bBuildLevels the shape has no pyramid, like the one queried before an async pyramid build is published
+	 */
+	void InitializeShape(const TArray<FVector2D>& InPoints, const FBox2D& InMinBox, const FBox2D& InMaxBox, bool bBuildLevels = true);
+
+	/** Returns the area space height interval (invalid if the area is infinitely tall) */
+	FFloatInterval GetVerticalExtent() const { return bHasVerticalExtent ? VerticalExtent : FFloatInterval(); }
+
+	/** Sets the area space height interval, invalid interval makes the area infinitely tall */
+	void SetVerticalExtent(const FFloatInterval& NewVerticalExtent);
+
+	/** Broadcast by SetVerticalExtent, so users indexing areas by their extents can update */
+	FOnPolygonAreaVerticalExtentChanged OnVerticalExtentChanged;
+
+	float GetLevelErrorBudget() const { return LevelErrorBudget; }
+	void SetLevelErrorBudget(float InLevelErrorBudget) { LevelErrorBudget = InLevelErrorBudget; }
+
+#if WITH_EDITOR
+	/**
+	 * Removes the points deviating from the boundary less than SimplifyMaxError (Visvalingam style),
+	 * keeping the polygon star-shaped and its sides no closer to the origin than MinRadius
+	 * Logs the point reduction and the closest point query time measured before and after
+	 */
+	UFUNCTION(CallInEditor, Category = "Editor|Simplify")
+	void SimplifyPolygon();
+#endif
+
+#if ENABLE_DRAW_DEBUG
+	/** Adds the polygon outline and the inscribed and bounding boxes to the debug line batch */
+	void AddDebugLines(TArray<FBatchedLine>& Lines, bool bOutline, bool bBoxes) const;
+#endif
 
 private:
+	/** Returns the polygon points packed in the area arena (or own Points if not registered) */
+	TArrayView<const FVector2D> GetPoints() const;
+
+	/** Returns the coarsest pyramid level, which error fits the LevelErrorBudget for the Location, nullptr for the full polygon */
+	const FPolygonAreaLevel* FindLevel(const FVector2D& Location) const;
+
+	/** Returns the points of the level picked by FindLevel */
+	TArrayView<const FVector2D> GetLevelPoints(const FVector2D& Location) const;
+
 	/**
 	 * Finds two adjacent points, which form a sector from the origin, which contains the Location
 	 * Returns the index of the first point
 	 */
-	int32 FindContainingSector(const FVector2D& Location);
+	static int32 FindContainingSector(TArrayView<const FVector2D> Polygon, const FVector2D& Location);
+
+	/** Returns true if the Location is inside the polygon in 2D, using the boxes and the containing sector triangle */
+	bool IsInside2D(TArrayView<const FVector2D> Polygon, const FVector2D& Location) const;
+
+	/** Appends crossings of one area space segment to OutCrossings, sorted along the segment */
+	template<typename AllocatorType>
+	void AddSegmentCrossings(int32 SegmentIndex, const FVector& Start, const FVector& End, TArray<FPolygonAreaCrossing, AllocatorType>& OutCrossings) const;
+
+	FVector FindClosestPointImpl(const FVector& Location, float* OutSignedDistance);
+
+	/**
+	 * Closest point query reporting the tested sector and the walked sides to the Trace
+	 * Game queries use the empty trace, so the instrumentation is compiled out of them, traces without bUseLevels query the full polygon
+	 */
+	template<typename TQueryTrace>
+	FVector FindClosestPointTraced(const FVector& Location, float* OutSignedDistance, TQueryTrace& Trace) const;
+
+	/** Returns the distance from the Location inside the polygon to its nearest side, walking from the containing sector both ways */
+	static float FindInsideDepth(TArrayView<const FVector2D> Polygon, int32 LeftIdx, const FVector2D& Location);
+
+	/** Returns Z clamped to the vertical extent (unchanged if the area is infinitely tall) */
+	float ClampToVerticalExtent(float Z) const { return bHasVerticalExtent ? FMath::Clamp(Z, VerticalExtent.Min, VerticalExtent.Max) : Z; }
+
+	/** Publishes the shape made of the current Points and bounds, building pyramid levels on a worker if allowed (or not at all without bBuildLevels) */
+	void ResetShape(bool bAllowAsync, bool bBuildLevels = true);
+
+	/** Starts building a shape from the RequestedPoints on a worker thread */
+	void StartRebuild();
+
+	/** Swaps the published shape, only on the game thread, so GetShape copies never race with the swap */
+	void PublishShape(FPolygonAreaShapePtr NewShape);
+
+	/** Returns true if the RequestedPoints are not published yet */
+	bool HasPendingPoints() const { return RebuildTask.IsValid() || bHasQueuedPoints; }
+
+	void OnOwnerTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	/** Refreshes cached area space transforms, called only when the owner transform changes */
+	void UpdateAreaTransform();
+
+	UPROPERTY(Transient)
+	UPolygonAreaSubsystem* AreaSubsystem;
+
+	FPolygonAreaHandle ArenaHandle;
+
+	/** Currently published polygon snapshot */
+	FPolygonAreaShapePtr Shape;
+
+	/** Shape being built on a worker thread (at most one at a time) */
+	TFuture<FPolygonAreaShapePtr> RebuildTask;
+
+	/** Latest points passed to SetPoints, kept until the published Shape catches up with them */
+	TArray<FVector2D> RequestedPoints;
+
+	/** RequestedPoints came while a rebuild was in flight and wait for the next one */
+	bool bHasQueuedPoints;
+
+	FMatrix WorldToAreaMatrix;
+	FMatrix AreaToWorldMatrix;
+	float AreaRadiusScale;
 
 	UPROPERTY()
 	TArray<FVector2D> Points;
@@ -45,11 +244,31 @@ private:
 	UPROPERTY()
 	FBox2D MaxBox;
 
+	/** Makes the area extruded over the VerticalExtent instead of being infinitely tall */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Area, meta = (AllowPrivateAccess = "true", InlineEditConditionToggle))
+	bool bHasVerticalExtent;
+
+	/** Area space height interval (floors and caves stacked in one actor use separate areas with their own intervals) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Area, meta = (AllowPrivateAccess = "true", EditCondition = "bHasVerticalExtent"))
+	FFloatInterval VerticalExtent;
+
+	/** Max closest point error allowed for distant listeners, relative to the listener distance to the area bounds */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Area, meta = (AllowPrivateAccess = "true", ClampMin = "0.0", ClampMax = "1.0"))
+	float LevelErrorBudget;
+
 
 #if WITH_EDITOR
-	void DrawDebugSegment(const FVector2D& A, const FVector2D& B);
-	void DrawDebugSide(const FVector2D& A, const FVector2D& B);
+	/** Returns the average FindClosestPoint time of the full Shape polygon for random locations around it */
+	static double MeasureQuerySeconds(const FPolygonAreaShape& Shape);
 
+	/** Runs FindClosestPoint for the area space Location, counting the work done */
+	FPolygonAreaQueryStats MeasureQueryCost(const FVector& Location) const;
+
+	friend class FPolygonArea2DComponentVisualiser;
+	friend class FPolygonAreaImporter;
+#endif
+
+#if WITH_EDITORONLY_DATA
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Editor, meta = (AllowPrivateAccess = "true"))
 	FLinearColor EditorSelectedColor;
 
@@ -62,15 +281,35 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Editor, meta = (AllowPrivateAccess = "true", ClampMin = "10.0"))
 	float MinRadius;
 
+	/** Max distance the boundary may move when simplified by SimplifyPolygon */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Editor|Simplify", meta = (AllowPrivateAccess = "true", ClampMin = "0.0"))
+	float SimplifyMaxError;
+
+	/** Lets sfx.Debug.DrawAreas draw the outline of this area */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Editor|Debug", meta = (AllowPrivateAccess = "true"))
 	bool bDrawArea;
 
+	/** Lets sfx.Debug.DrawBoxes draw the boxes of this area */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Editor|Debug", meta = (AllowPrivateAccess = "true"))
 	bool bDrawBoxes;
 
+	/**
+	 * Draws the closest point query cost for listeners around the area (full polygon, no simplification levels):
+	 * blue - inside the inscribed box, green - inside the containing sector triangle, yellow to red - number of sides walked
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Editor|Debug", meta = (AllowPrivateAccess = "true"))
-	bool bDrawTestedSegments;
+	bool bDrawQueryCostHeatmap;
 
-	friend class FPolygonArea2DComponentVisualiser;
+	/** Distance around the MaxBox covered by the heatmap, usually the event attenuation radius */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Editor|Debug", meta = (AllowPrivateAccess = "true", ClampMin = "0.0", EditCondition = "bDrawQueryCostHeatmap"))
+	float QueryHeatmapMargin;
+
+	/** Number of heatmap samples along each axis */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Editor|Debug", meta = (AllowPrivateAccess = "true", ClampMin = "2", ClampMax = "256", EditCondition = "bDrawQueryCostHeatmap"))
+	int32 QueryHeatmapResolution;
+
+	/** Number of walked sides drawn red */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Editor|Debug", meta = (AllowPrivateAccess = "true", ClampMin = "1", EditCondition = "bDrawQueryCostHeatmap"))
+	int32 QueryHeatmapMaxSides;
 #endif
 };
@@ -3,4 +3,34 @@
 #include "SFXUtilities.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_GAME_MODULE( FDefaultGameModuleImpl, SFXUtilities )
\ No newline at end of file
+#if ENABLE_DRAW_DEBUG
+#include "SFXUtilities/Utilities/DebugDrawUtils.h"
+
+#include "Engine/World.h"
+#endif
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+DECLARE_LLM_MEMORY_STAT(TEXT("SFXUtilities"), STAT_SFXUtilitiesLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("SFXUtilities"), STAT_SFXUtilitiesSummaryLLM, STATGROUP_LLM);
+#endif
+
+IMPLEMENT_GAME_MODULE( FSFXUtilities, SFXUtilities )
+
+void FSFXUtilities::StartupModule()
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	FLowLevelMemTracker::Get().RegisterProjectTag(static_cast<int32>(ELLMTag_SFXUtilities), TEXT("SFXUtilities"),
+		GET_STATFNAME(STAT_SFXUtilitiesLLM), GET_STATFNAME(STAT_SFXUtilitiesSummaryLLM));
+#endif
+
+#if ENABLE_DRAW_DEBUG
+	DebugDrawHandle = FWorldDelegates::OnWorldPostActorTick.AddStatic(&Utils::DebugDraw::DrawWorld);
+#endif
+}
+
+void FSFXUtilities::ShutdownModule()
+{
+#if ENABLE_DRAW_DEBUG
+	FWorldDelegates::OnWorldPostActorTick.Remove(DebugDrawHandle);
+#endif
+}
\ No newline at end of file
@@ -2,4 +2,28 @@
 
 #pragma once
 
-#include "CoreMinimal.h"
\ No newline at end of file
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Modules/ModuleInterface.h"
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+/** Low level memory tracker tag of area polygons, arenas, emitters and their FMOD instances */
+constexpr ELLMTag ELLMTag_SFXUtilities = static_cast<ELLMTag>(static_cast<int32>(ELLMTag::ProjectTagStart) + 0);
+
+#define SFX_LLM_SCOPE() LLM_SCOPE(ELLMTag_SFXUtilities)
+#else
+#define SFX_LLM_SCOPE()
+#endif
+
+class FSFXUtilities : public IModuleInterface
+{
+public:
+	// Begin IModuleInterface implementation
+	void StartupModule() override;
+	void ShutdownModule() override;
+	// End IModuleInterface implementation
+
+private:
+	/** Debug draw pass run after the actor tick of every world */
+	FDelegateHandle DebugDrawHandle;
+};
\ No newline at end of file
@@ -0,0 +1,224 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PolygonAreaSubsystem.h"
+
+#include "SFXUtilities/Actors/FMODVolumetricEmitter.h"
+#include "SFXUtilities/Components/PolygonArea2DComponent.h"
+#include "SFXUtilities/SFXUtilities.h"
+
+#include "Algo/Sort.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+	FAutoConsoleCommandWithWorld DumpMemoryCommand(
+		TEXT("sfx.Areas.DumpMemory"),
+		TEXT("Logs memory footprint of every playing polygon area sorted by size, followed by the arena and emitter totals."),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (const UPolygonAreaSubsystem* Subsystem = World != nullptr ? World->GetSubsystem<UPolygonAreaSubsystem>() : nullptr)
+			{
+				Subsystem->DumpMemory();
+			}
+		}));
+}
+
+void UPolygonAreaSubsystem::Deinitialize()
+{
+	Arena = FPolygonAreaArena();
+	Areas.Empty();
+
+	Super::Deinitialize();
+}
+
+FPolygonAreaHandle UPolygonAreaSubsystem::RegisterArea(UPolygonArea2DComponent* Area, TArrayView<const FVector2D> Points, const FBox2D& MinBox, const FBox2D& MaxBox, const FFloatInterval& VerticalExtent, const FTransform& Transform)
+{
+	check(Area != nullptr);
+
+	SFX_LLM_SCOPE();
+
+	FPolygonAreaHandle Handle = Arena.Add(Points, MinBox, MaxBox, VerticalExtent, Transform);
+
+	if (Handle.GetIndex() >= Areas.Num())
+	{
+		Areas.SetNumZeroed(Handle.GetIndex() + 1);
+	}
+	Areas[Handle.GetIndex()] = Area;
+
+	return Handle;
+}
+
+void UPolygonAreaSubsystem::UnregisterArea(FPolygonAreaHandle& Handle)
+{
+	if (!Arena.IsValid(Handle)) return;
+
+	Areas[Handle.GetIndex()] = nullptr;
+	Arena.Remove(Handle);
+	Handle.Invalidate();
+
+	// Areas stream out in bulk, so compaction cost is amortized over many removals
+	if (Arena.IsCompactionNeeded())
+	{
+		Arena.Compact();
+	}
+}
+
+void UPolygonAreaSubsystem::UpdateArea(FPolygonAreaHandle Handle, TArrayView<const FVector2D> Points, const FBox2D& MinBox, const FBox2D& MaxBox, const FFloatInterval& VerticalExtent, const FTransform& Transform)
+{
+	if (!Arena.IsValid(Handle)) return;
+
+	SFX_LLM_SCOPE();
+
+	Arena.Update(Handle, Points, MinBox, MaxBox, VerticalExtent, Transform);
+
+	// Growing polygons leave their old points behind
+	if (Arena.IsCompactionNeeded())
+	{
+		Arena.Compact();
+	}
+}
+
+void UPolygonAreaSubsystem::FindAreasWithinRadius(const FVector& Location, float Radius, TArray<UPolygonArea2DComponent*>& OutAreas) const
+{
+	TArray<FPolygonAreaHandle> Handles;
+	Arena.FindWithinRadius(Location, Radius, Handles);
+
+	OutAreas.Reserve(OutAreas.Num() + Handles.Num());
+	for (FPolygonAreaHandle Handle : Handles)
+	{
+		OutAreas.Add(Areas[Handle.GetIndex()]);
+	}
+}
+
+void UPolygonAreaSubsystem::FindContainingAreas(const FVector& Location, TArray<UPolygonArea2DComponent*>& OutAreas)
+{
+	SFX_LLM_SCOPE();
+
+	CandidateHandles.Reset();
+	Arena.FindContaining(Location, CandidateHandles);
+
+	for (FPolygonAreaHandle Handle : CandidateHandles)
+	{
+		UPolygonArea2DComponent* Area = Areas[Handle.GetIndex()];
+		if (Area->IsInside(Area->WorldToArea(Location)))
+		{
+			OutAreas.Add(Area);
+		}
+	}
+}
+
+void UPolygonAreaSubsystem::FindContainingAreas(TArrayView<const FVector> Locations, TArray<FPolygonAreaMembership>& OutMemberships)
+{
+	SFX_LLM_SCOPE();
+
+	for (int32 LocationIndex = 0; LocationIndex < Locations.Num(); LocationIndex++)
+	{
+		const FVector& Location = Locations[LocationIndex];
+
+		CandidateHandles.Reset();
+		Arena.FindContaining(Location, CandidateHandles);
+
+		for (FPolygonAreaHandle Handle : CandidateHandles)
+		{
+			UPolygonArea2DComponent* Area = Areas[Handle.GetIndex()];
+			if (Area->IsInside(Area->WorldToArea(Location)))
+			{
+				OutMemberships.Add({ LocationIndex, Area });
+			}
+		}
+	}
+}
+
+void UPolygonAreaSubsystem::FindAreaTransitions(TArrayView<const FVector> Starts, TArrayView<const FVector> Ends, TArray<FPolygonAreaTransition>& OutTransitions)
+{
+	check(Starts.Num() == Ends.Num());
+
+	SFX_LLM_SCOPE();
+
+	TArray<FPolygonAreaCrossing> Crossings;
+
+	for (int32 SegmentIndex = 0; SegmentIndex < Starts.Num(); SegmentIndex++)
+	{
+		const FVector& Start = Starts[SegmentIndex];
+		const FVector& End = Ends[SegmentIndex];
+
+		// Areas touching the segment are within its half length from the middle
+		CandidateHandles.Reset();
+		Arena.FindWithinRadius((Start + End) * 0.5f, FVector::Dist(Start, End) * 0.5f, CandidateHandles);
+
+		const int32 FirstTransition = OutTransitions.Num();
+		for (FPolygonAreaHandle Handle : CandidateHandles)
+		{
+			UPolygonArea2DComponent* Area = Areas[Handle.GetIndex()];
+
+			// Fractions of the segment are the same in both spaces
+			Crossings.Reset();
+			Area->FindSegmentCrossings(Area->WorldToArea(Start), Area->WorldToArea(End), Crossings);
+
+			for (FPolygonAreaCrossing& Crossing : Crossings)
+			{
+				Crossing.SegmentIndex = SegmentIndex;
+				Crossing.Location = Area->AreaToWorld(Crossing.Location);
+				OutTransitions.Add({ Area, Crossing });
+			}
+		}
+
+		const int32 NumTransitions = OutTransitions.Num() - FirstTransition;
+		if (NumTransitions > 1)
+		{
+			Algo::SortBy(MakeArrayView(OutTransitions.GetData() + FirstTransition, NumTransitions),
+				[](const FPolygonAreaTransition& Transition) { return Transition.Crossing.Time; });
+		}
+	}
+}
+
+UPolygonArea2DComponent* UPolygonAreaSubsystem::GetArea(FPolygonAreaHandle Handle) const
+{
+	return Arena.IsValid(Handle) ? Areas[Handle.GetIndex()] : nullptr;
+}
+
+void UPolygonAreaSubsystem::DumpMemory() const
+{
+	struct FAreaMemory
+	{
+		const UPolygonArea2DComponent* Area;
+		SIZE_T Size;
+	};
+
+	TArray<FAreaMemory> AreaMemory;
+	SIZE_T TotalAreaSize = 0;
+
+	for (const UPolygonArea2DComponent* Area : Areas)
+	{
+		if (Area == nullptr) continue;
+
+		const SIZE_T Size = const_cast<UPolygonArea2DComponent*>(Area)->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		AreaMemory.Add({ Area, Size });
+		TotalAreaSize += Size;
+	}
+
+	AreaMemory.Sort([](const FAreaMemory& A, const FAreaMemory& B) { return A.Size > B.Size; });
+
+	UE_LOG(LogTemp, Log, TEXT("Polygon area memory (%d areas):"), AreaMemory.Num());
+	for (const FAreaMemory& Entry : AreaMemory)
+	{
+		UE_LOG(LogTemp, Log, TEXT("  %10.2f KB  %6d points  %s"), Entry.Size / 1024.f, Entry.Area->GetShape().IsValid() ? Entry.Area->GetShape()->Points.Num() : 0, *Entry.Area->GetPathName());
+	}
+
+	// Emitter sizes exclude their slices, which are listed above
+	int32 NumEmitters = 0;
+	SIZE_T TotalEmitterSize = 0;
+	for (TActorIterator<AFMODVolumetricEmitter> It(GetWorld()); It; ++It)
+	{
+		NumEmitters++;
+		TotalEmitterSize += It->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+	}
+
+	// Area sizes include their packed points, the rest of the arena is bookkeeping, the grid and dead points
+	const SIZE_T ArenaSize = Arena.GetAllocatedSize();
+
+	UE_LOG(LogTemp, Log, TEXT("  Areas:    %10.2f KB"), TotalAreaSize / 1024.f);
+	UE_LOG(LogTemp, Log, TEXT("  Arena:    %10.2f KB (%d live points)"), ArenaSize / 1024.f, Arena.GetNumPoints());
+	UE_LOG(LogTemp, Log, TEXT("  Emitters: %10.2f KB (%d emitters)"), TotalEmitterSize / 1024.f, NumEmitters);
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "SFXUtilities/Components/PolygonArea2DComponent.h"
+#include "SFXUtilities/Utilities/PolygonAreaArena.h"
+
+#include "PolygonAreaSubsystem.generated.h"
+
+struct FPolygonAreaMembership
+{
+	int32 LocationIndex;
+	UPolygonArea2DComponent* Area;
+};
+
+/** Area boundary crossing of a world space segment, the crossing Location is in the world space */
+struct FPolygonAreaTransition
+{
+	UPolygonArea2DComponent* Area;
+	FPolygonAreaCrossing Crossing;
+};
+
+/**
+ * Keeps polygons of all areas playing in the world packed in one arena
+ */
+UCLASS()
+class SFXUTILITIES_API UPolygonAreaSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Begin USubsystem interface
+	void Deinitialize() override;
+	// End USubsystem interface
+
+	FPolygonAreaHandle RegisterArea(UPolygonArea2DComponent* Area, TArrayView<const FVector2D> Points, const FBox2D& MinBox, const FBox2D& MaxBox, const FFloatInterval& VerticalExtent, const FTransform& Transform);
+	void UnregisterArea(FPolygonAreaHandle& Handle);
+	void UpdateArea(FPolygonAreaHandle Handle, TArrayView<const FVector2D> Points, const FBox2D& MinBox, const FBox2D& MaxBox, const FFloatInterval& VerticalExtent, const FTransform& Transform);
+
+	/** Collects the areas, which bounding box is within Radius from the world Location */
+	void FindAreasWithinRadius(const FVector& Location, float Radius, TArray<UPolygonArea2DComponent*>& OutAreas) const;
+
+	/** Collects the areas containing the world Location */
+	void FindContainingAreas(const FVector& Location, TArray<UPolygonArea2DComponent*>& OutAreas);
+
+	/** Classifies many world Locations at once, OutMemberships go in the order of the Locations */
+	void FindContainingAreas(TArrayView<const FVector> Locations, TArray<FPolygonAreaMembership>& OutMemberships);
+
+	/**
+	 * Collects boundary crossings of the world space segments (Starts[i], Ends[i]) with all areas, e.g. listener moves between frames or propagation paths
+	 * OutTransitions go in the order of the segments, transitions of one segment are sorted along it
+	 */
+	void FindAreaTransitions(TArrayView<const FVector> Starts, TArrayView<const FVector> Ends, TArray<FPolygonAreaTransition>& OutTransitions);
+
+	UPolygonArea2DComponent* GetArea(FPolygonAreaHandle Handle) const;
+
+	/** Logs memory of every registered area sorted by size, the arena and the volumetric emitters of the world */
+	void DumpMemory() const;
+
+	FPolygonAreaArena& GetArena() { return Arena; }
+	const FPolygonAreaArena& GetArena() const { return Arena; }
+
+private:
+	FPolygonAreaArena Arena;
+
+	/** Registered components indexed by the handle index */
+	UPROPERTY(Transient)
+	TArray<UPolygonArea2DComponent*> Areas;
+
+	/** Candidate areas of a point query, kept to avoid allocations per query */
+	TArray<FPolygonAreaHandle> CandidateHandles;
+};
\ No newline at end of file
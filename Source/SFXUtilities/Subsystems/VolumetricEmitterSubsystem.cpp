@@ -0,0 +1,368 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "VolumetricEmitterSubsystem.h"
+
+#include "SFXUtilities/Actors/FMODVolumetricEmitter.h"
+#include "SFXUtilities/SFXUtilities.h"
+#include "SFXUtilities/Utilities/FMODVolumetricAudioBackend.h"
+#include "SFXUtilities/Utilities/NullVolumetricAudioBackend.h"
+
+#include "FMODStudioModule.h"
+
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarOcclusionMaxTracesPerFrame(
+		TEXT("sfx.Occlusion.MaxTracesPerFrame"),
+		16,
+		TEXT("Max number of async occlusion traces issued by volumetric emitters per frame."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int32> CVarMaxVoices(
+		TEXT("sfx.Voices.MaxVolumetric"),
+		32,
+		TEXT("Max number of volumetric emitters playing at once, the least audible ones are virtualized (0 = unlimited)."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarVoiceHysteresis(
+		TEXT("sfx.Voices.Hysteresis"),
+		0.1f,
+		TEXT("Audibility bonus of playing volumetric emitters, prevents emitters with close audibility from swapping every frame."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarActivationBudgetMs(
+		TEXT("sfx.Streaming.ActivationBudgetMs"),
+		0.5f,
+		TEXT("Time per frame spent activating volumetric emitters of streamed in levels (at least one emitter is activated per frame)."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int32> CVarMaxPooledPerEvent(
+		TEXT("sfx.Voices.MaxPooledPerEvent"),
+		8,
+		TEXT("Max number of stopped FMOD event instances kept for reuse per event."),
+		ECVF_Default);
+
+	FAutoConsoleCommandWithWorldAndArgs StartRecordingCommand(
+		TEXT("sfx.Record.Start"),
+		TEXT("Starts recording listener path and volumetric emitter queries. Optional argument is the file name (Saved/Profiling/VolumetricQueries.vqr by default)."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UVolumetricEmitterSubsystem* Subsystem = World != nullptr ? World->GetSubsystem<UVolumetricEmitterSubsystem>() : nullptr)
+			{
+				Subsystem->StartRecording(Args.Num() > 0 ? Args[0] : FPaths::ProfilingDir() / TEXT("VolumetricQueries.vqr"));
+			}
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs StopRecordingCommand(
+		TEXT("sfx.Record.Stop"),
+		TEXT("Stops recording volumetric emitter queries and saves the recording."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UVolumetricEmitterSubsystem* Subsystem = World != nullptr ? World->GetSubsystem<UVolumetricEmitterSubsystem>() : nullptr)
+			{
+				Subsystem->StopRecording();
+			}
+		}));
+}
+
+void UVolumetricEmitterSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("SFXNullAudio")) || !IFMODStudioModule::IsAvailable())
+	{
+		AudioBackend = MakeUnique<FNullVolumetricAudioBackend>();
+	}
+	else
+	{
+		AudioBackend = MakeUnique<FFMODVolumetricAudioBackend>();
+	}
+}
+
+void UVolumetricEmitterSubsystem::Deinitialize()
+{
+	StopRecording();
+
+	Emitters.Empty();
+	QueuedActivations.Empty();
+	QueueHead = 0;
+	PendingTraces.Empty();
+	AudioBackend.Reset();
+
+	Super::Deinitialize();
+}
+
+void UVolumetricEmitterSubsystem::Tick(float DeltaTime)
+{
+	SFX_LLM_SCOPE();
+
+	AudioBackend->SetMaxPooledPerEvent(CVarMaxPooledPerEvent.GetValueOnGameThread());
+
+	if (QueuedActivations.Num() > 0)
+	{
+		ActivateQueuedEmitters(CVarActivationBudgetMs.GetValueOnGameThread() / 1000.0);
+	}
+
+	UpdateVoiceBudget();
+	ApplyOcclusionTraces();
+	IssueOcclusionTraces();
+
+	if (Recorder.IsValid())
+	{
+		FVector ListenerLocation = FVector::ZeroVector;
+		FRotator ListenerRotation = FRotator::ZeroRotator;
+
+		if (APlayerController* PlayerController = GetWorld()->GetFirstPlayerController())
+		{
+			FVector FrontDir, RightDir;
+			PlayerController->GetAudioListenerPosition(ListenerLocation, FrontDir, RightDir);
+			ListenerRotation = FRotationMatrix::MakeFromXY(FrontDir, RightDir).Rotator();
+		}
+
+		Recorder->EndFrame(DeltaTime, ListenerLocation, ListenerRotation);
+	}
+}
+
+bool UVolumetricEmitterSubsystem::IsTickable() const
+{
+	return Emitters.Num() > 0 || QueuedActivations.Num() > 0 || PendingTraces.Num() > 0 || Recorder.IsValid();
+}
+
+ETickableTickType UVolumetricEmitterSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+TStatId UVolumetricEmitterSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVolumetricEmitterSubsystem, STATGROUP_Tickables);
+}
+
+void UVolumetricEmitterSubsystem::QueueEmitterActivation(AFMODVolumetricEmitter* Emitter)
+{
+	check(Emitter != nullptr);
+	QueuedActivations.Add(Emitter);
+}
+
+void UVolumetricEmitterSubsystem::FlushEmitterActivations()
+{
+	ActivateQueuedEmitters(MAX_dbl);
+}
+
+void UVolumetricEmitterSubsystem::ActivateQueuedEmitters(double BudgetSeconds)
+{
+	SFX_LLM_SCOPE();
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Activation may unregister emitters, which removes them from the queue, so each one is taken off the head before it activates
+	while (QueueHead < QueuedActivations.Num())
+	{
+		// Emitters leave the queue on EndPlay, but GC clears the entry of one destroyed without it
+		if (AFMODVolumetricEmitter* Emitter = QueuedActivations[QueueHead++])
+		{
+			Emitter->ActivateEmitter();
+		}
+
+		if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds) break;
+	}
+
+	QueuedActivations.RemoveAt(0, QueueHead, false);
+	QueueHead = 0;
+}
+
+void UVolumetricEmitterSubsystem::RegisterEmitter(AFMODVolumetricEmitter* Emitter)
+{
+	check(Emitter != nullptr);
+	Emitters.Add({ Emitter, 0u });
+}
+
+void UVolumetricEmitterSubsystem::UnregisterEmitter(AFMODVolumetricEmitter* Emitter)
+{
+	// Emitters of a level streamed out before their turn never activate, the ones before the head are already playing
+	const int32 QueuedIndex = MakeArrayView(QueuedActivations).Slice(QueueHead, QueuedActivations.Num() - QueueHead).Find(Emitter);
+	if (QueuedIndex != INDEX_NONE)
+	{
+		QueuedActivations.RemoveAt(QueueHead + QueuedIndex, 1, false);
+		return;
+	}
+
+	const int32 Index = Emitters.IndexOfByPredicate([Emitter](const FEmitterEntry& Entry) { return Entry.Emitter == Emitter; });
+	if (Index != INDEX_NONE)
+	{
+		Emitters.RemoveAtSwap(Index, 1, false);
+	}
+
+	// In flight traces are not waited for, their results are just skipped
+	PendingTraces.RemoveAllSwap([Emitter](const FPendingTrace& Trace) { return Trace.Emitter.Get() == Emitter; }, false);
+}
+
+void UVolumetricEmitterSubsystem::SetAudioBackend(TUniquePtr<IVolumetricAudioBackend> NewAudioBackend)
+{
+	// Playing emitters hold instances of the current backend
+	checkf(Emitters.Num() == 0, TEXT("Audio backend can't be replaced while volumetric emitters are playing"));
+	check(NewAudioBackend.IsValid());
+
+	AudioBackend = MoveTemp(NewAudioBackend);
+}
+
+void UVolumetricEmitterSubsystem::StartRecording(const FString& Filename)
+{
+	StopRecording();
+
+	Recorder = MakeUnique<FVolumetricQueryRecorder>();
+	RecordingFilename = Filename;
+}
+
+void UVolumetricEmitterSubsystem::StopRecording()
+{
+	if (!Recorder.IsValid()) return;
+
+	FVolumetricQueryRecording& Recording = Recorder->GetRecording();
+	if (Recording.SaveToFile(RecordingFilename))
+	{
+		UE_LOG(LogTemp, Log, TEXT("Saved %d frames of volumetric queries to %s"), Recording.Frames.Num(), *RecordingFilename);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to save volumetric queries to %s"), *RecordingFilename);
+	}
+
+	Recorder.Reset();
+}
+
+void UVolumetricEmitterSubsystem::UpdateVoiceBudget()
+{
+	const int32 MaxVoices = CVarMaxVoices.GetValueOnGameThread();
+	const float Hysteresis = CVarVoiceHysteresis.GetValueOnGameThread();
+
+	struct FRankedEmitter
+	{
+		float Score;
+		AFMODVolumetricEmitter* Emitter;
+
+		bool operator<(const FRankedEmitter& Other) const { return Score > Other.Score; }
+	};
+
+	TArray<FRankedEmitter, TInlineAllocator<64>> Ranked;
+	for (const FEmitterEntry& Entry : Emitters)
+	{
+		AFMODVolumetricEmitter* Emitter = Entry.Emitter;
+
+		const float Audibility = Emitter->GetAudibility();
+		if (Audibility <= 0.f)
+		{
+			// Out of range emitters never take a voice
+			Emitter->SetVoiceActive(false);
+			continue;
+		}
+
+		Ranked.Add({ Audibility + (Emitter->IsVoiceActive() ? Hysteresis : 0.f), Emitter });
+	}
+
+	if (MaxVoices > 0 && Ranked.Num() > MaxVoices)
+	{
+		Ranked.Sort();
+	}
+
+	for (int32 Index = 0; Index < Ranked.Num(); Index++)
+	{
+		Ranked[Index].Emitter->SetVoiceActive(MaxVoices <= 0 || Index < MaxVoices);
+	}
+}
+
+void UVolumetricEmitterSubsystem::ApplyOcclusionTraces()
+{
+	UWorld* World = GetWorld();
+
+	for (int32 Index = PendingTraces.Num() - 1; Index >= 0; Index--)
+	{
+		const FPendingTrace& Trace = PendingTraces[Index];
+
+		FTraceDatum TraceData;
+		if (!World->QueryTraceData(Trace.Handle, TraceData))
+		{
+			// Results are not available yet (or were lost with the world trace buffers)
+			if (!World->IsTraceHandleValid(Trace.Handle, false))
+			{
+				PendingTraces.RemoveAtSwap(Index, 1, false);
+			}
+			continue;
+		}
+
+		if (AFMODVolumetricEmitter* Emitter = Trace.Emitter.Get())
+		{
+			const bool bOccluded = TraceData.OutHits.Num() > 0 && TraceData.OutHits[0].bBlockingHit;
+			Emitter->SetOcclusionTarget(bOccluded ? 1.f : 0.f);
+		}
+
+		PendingTraces.RemoveAtSwap(Index, 1, false);
+	}
+}
+
+void UVolumetricEmitterSubsystem::IssueOcclusionTraces()
+{
+	const int32 MaxTraces = CVarOcclusionMaxTracesPerFrame.GetValueOnGameThread();
+	if (MaxTraces <= 0) return;
+
+	struct FCandidate
+	{
+		float Priority;
+		int32 EntryIndex;
+		FVector Start;
+		FVector End;
+
+		bool operator<(const FCandidate& Other) const { return Priority < Other.Priority; }
+	};
+
+	const uint64 FrameNumber = GFrameCounter;
+
+	// Emitters wait for the traces they have in flight, so slow frames do not pile up traces applied out of order
+	TSet<const AFMODVolumetricEmitter*, DefaultKeyFuncs<const AFMODVolumetricEmitter*>, TInlineSetAllocator<64>> TracedEmitters;
+	for (const FPendingTrace& Trace : PendingTraces)
+	{
+		TracedEmitters.Add(Trace.Emitter.Get());
+	}
+
+	TArray<FCandidate, TInlineAllocator<64>> Candidates;
+	for (int32 EntryIndex = 0; EntryIndex < Emitters.Num(); EntryIndex++)
+	{
+		const FEmitterEntry& Entry = Emitters[EntryIndex];
+		if (TracedEmitters.Contains(Entry.Emitter)) continue;
+
+		FCandidate Candidate;
+		if (!Entry.Emitter->GetOcclusionTrace(Candidate.Start, Candidate.End)) continue;
+
+		// Close emitters are traced often, distant ones wait longer, but never starve
+		const float FramesSinceTrace = static_cast<float>(FrameNumber - Entry.LastTraceFrame);
+		Candidate.Priority = FVector::DistSquared(Candidate.Start, Candidate.End) / (FramesSinceTrace * FramesSinceTrace);
+		Candidate.EntryIndex = EntryIndex;
+		Candidates.Add(Candidate);
+	}
+
+	Candidates.Sort();
+
+	UWorld* World = GetWorld();
+	const int32 NumTraces = FMath::Min(MaxTraces, Candidates.Num());
+	for (int32 Index = 0; Index < NumTraces; Index++)
+	{
+		const FCandidate& Candidate = Candidates[Index];
+		FEmitterEntry& Entry = Emitters[Candidate.EntryIndex];
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(VolumetricEmitterOcclusion), false, Entry.Emitter);
+
+		FPendingTrace Trace;
+		Trace.Handle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single,
+			Candidate.Start, Candidate.End, Entry.Emitter->GetOcclusionTraceChannel(), QueryParams);
+		Trace.Emitter = Entry.Emitter;
+		PendingTraces.Add(Trace);
+
+		Entry.LastTraceFrame = FrameNumber;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "WorldCollision.h"
+
+#include "SFXUtilities/Utilities/VolumetricAudioBackend.h"
+#include "SFXUtilities/Utilities/VolumetricQueryRecording.h"
+
+#include "VolumetricEmitterSubsystem.generated.h"
+
+class AFMODVolumetricEmitter;
+
+/**
+ * Runs the work shared by all volumetric emitters in the world:
+ * activates emitters of streamed in levels in time-sliced batches (sfx.Streaming.ActivationBudgetMs),
+ * keeps only the most audible emitters playing within the voice budget,
+ * plays emitters near the listener through the audio backend (FMOD, or the null one with -SFXNullAudio or without FMOD),
+ * batches listener-to-emitter occlusion traces, prioritized by distance and throttled per frame,
+ * records listener path and emitter queries for the headless replay (sfx.Record.Start / sfx.Record.Stop)
+ */
+UCLASS()
+class SFXUTILITIES_API UVolumetricEmitterSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	// Begin USubsystem interface
+	void Initialize(FSubsystemCollectionBase& Collection) override;
+	void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	void Tick(float DeltaTime) override;
+	bool IsTickable() const override;
+	ETickableTickType GetTickableTickType() const override;
+	TStatId GetStatId() const override;
+	// End FTickableGameObject interface
+
+	/** Queues the emitter beginning play, it is activated by a later tick within the per-frame activation budget */
+	void QueueEmitterActivation(AFMODVolumetricEmitter* Emitter);
+
+	/** Activates all queued emitters at once (tests, loading screens) */
+	void FlushEmitterActivations();
+
+	/** Adds the activated emitter to the per-frame processing */
+	void RegisterEmitter(AFMODVolumetricEmitter* Emitter);
+
+	/** Removes the emitter from the activation queue and all per-frame processing, called when it ends play or streams out */
+	void UnregisterEmitter(AFMODVolumetricEmitter* Emitter);
+
+	/** Calls Func with every registered emitter */
+	template<typename FuncType>
+	void ForEachEmitter(FuncType Func) const
+	{
+		for (const FEmitterEntry& Entry : Emitters)
+		{
+			Func(*Entry.Emitter);
+		}
+	}
+
+	IVolumetricAudioBackend& GetAudioBackend() { return *AudioBackend; }
+
+	/** Replaces the audio backend (e.g. with FNullVolumetricAudioBackend in tests), must be called before any emitter begins play */
+	void SetAudioBackend(TUniquePtr<IVolumetricAudioBackend> NewAudioBackend);
+
+	/** Starts recording listener path and emitter queries, saved to Filename on StopRecording */
+	void StartRecording(const FString& Filename);
+	void StopRecording();
+
+	/** Returns the recorder if recording, emitters report their queries to it */
+	FVolumetricQueryRecorder* GetRecorder() const { return Recorder.Get(); }
+
+private:
+	/** Activates queued emitters in the queue order until BudgetSeconds run out, at least one per call so the queue always drains */
+	void ActivateQueuedEmitters(double BudgetSeconds);
+
+	/** Starts the most audible emitters within the voice budget and stops the rest */
+	void UpdateVoiceBudget();
+
+	/** Applies traces issued last frame */
+	void ApplyOcclusionTraces();
+
+	/** Issues async traces for the emitters, which need them most */
+	void IssueOcclusionTraces();
+
+	struct FEmitterEntry
+	{
+		AFMODVolumetricEmitter* Emitter;
+		uint64 LastTraceFrame;
+	};
+
+	struct FPendingTrace
+	{
+		FTraceHandle Handle;
+		TWeakObjectPtr<AFMODVolumetricEmitter> Emitter;
+	};
+
+	TArray<FEmitterEntry> Emitters;
+
+	/** Emitters, which have begun play, waiting for activation */
+	UPROPERTY(Transient)
+	TArray<AFMODVolumetricEmitter*> QueuedActivations;
+
+	/** Index of the next queued emitter to activate, entries before it are activated but not yet removed from the queue */
+	int32 QueueHead = 0;
+
+	TArray<FPendingTrace> PendingTraces;
+
+	TUniquePtr<IVolumetricAudioBackend> AudioBackend;
+
+	TUniquePtr<FVolumetricQueryRecorder> Recorder;
+	FString RecordingFilename;
+};
\ No newline at end of file
@@ -0,0 +1,277 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SFXUtilities/Components/PolygonArea2DComponent.h"
+#include "SFXUtilities/Tests/PolygonAreaTestUtils.h"
+#include "SFXUtilities/Utilities/PolygonAreaShape.h"
+
+#include "Algo/Sort.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	constexpr int32 RandomSeed = 0xC55;
+	constexpr int32 NumRandomPolygons = 50;
+	constexpr int32 NumRandomSegments = 200;
+
+	const FFloatInterval TestVerticalExtent(0.f, 300.f);
+
+	/** Integer coordinates keep the crossings at vertices exact, point 1 is a reflex vertex */
+	TArray<FVector2D> MakeFixedPolygon()
+	{
+		return {
+			{ 400.f, 0.f }, { 200.f, 100.f }, { 300.f, 300.f }, { 0.f, 500.f }, { -300.f, 300.f },
+			{ -400.f, 0.f }, { -200.f, -200.f }, { 0.f, -300.f }, { 300.f, -300.f } };
+	}
+
+	struct FExpectedCrossing
+	{
+		int32 SideIndex;
+		bool bEntering;
+	};
+
+	struct FFixedSegment
+	{
+		const TCHAR* Name;
+		FVector Start;
+		FVector End;
+		TArray<FExpectedCrossing> Crossings;
+		bool bTouching; // Segment only touches a vertex, which the half-open side parameter reports as one crossing of either direction
+	};
+
+	TArray<FFixedSegment> MakeFixedSegments()
+	{
+		return {
+			{ TEXT("From the origin"), { 0.f, 0.f, 100.f }, { -600.f, -100.f, 100.f }, { { 5, false } }, false },
+			{ TEXT("Through the origin"), { -600.f, -100.f, 100.f }, { 600.f, 100.f, 100.f }, { { 5, true }, { 0, false } }, false },
+			{ TEXT("Through the origin and two vertices"), { -600.f, 0.f, 100.f }, { 600.f, 0.f, 100.f }, { { 5, true }, { 0, false } }, false },
+			{ TEXT("Along a vertex ray"), { 0.f, 400.f, 100.f }, { 0.f, 600.f, 100.f }, { { 3, false } }, false },
+			{ TEXT("Across a vertex"), { -100.f, 400.f, 100.f }, { 100.f, 600.f, 100.f }, { { 3, false } }, false },
+			{ TEXT("Touching the top vertex"), { -100.f, 500.f, 100.f }, { 100.f, 500.f, 100.f }, { { 3, true } }, true },
+			{ TEXT("Touching the left vertex"), { -400.f, -100.f, 100.f }, { -400.f, 100.f, 100.f }, { { 5, true } }, true },
+			{ TEXT("Through both caps"), { 50.f, 50.f, -100.f }, { 50.f, 50.f, 400.f }, { { INDEX_NONE, true }, { INDEX_NONE, false } }, false },
+			{ TEXT("Through the top cap"), { 0.f, 0.f, 150.f }, { 200.f, 0.f, 450.f }, { { INDEX_NONE, false } }, false },
+			{ TEXT("Through a side below the top cap"), { 0.f, 0.f, 150.f }, { 800.f, 0.f, 350.f }, { { 0, false } }, false },
+			{ TEXT("Vertical outside"), { 1000.f, 0.f, -100.f }, { 1000.f, 0.f, 400.f }, {}, false },
+		};
+	}
+
+	UPolygonArea2DComponent* MakeArea(const TArray<FVector2D>& Points)
+	{
+		FPolygonAreaShapePtr Shape = FPolygonAreaShape::Build(Points);
+		if (!Shape.IsValid()) return nullptr;
+
+		UPolygonArea2DComponent* Area = NewObject<UPolygonArea2DComponent>(GetTransientPackage());
+		Area->InitializeShape(Shape->Points, Shape->MinBox, Shape->MaxBox);
+		Area->SetVerticalExtent(TestVerticalExtent);
+		return Area;
+	}
+
+	/** Even-odd rule, independent of the sector search */
+	bool IsInsideBruteForce(TArrayView<const FVector2D> Polygon, const FVector2D& Location)
+	{
+		bool bInside = false;
+
+		FVector2D LastPoint = Polygon.Last();
+		for (const FVector2D& Point : Polygon)
+		{
+			if ((Point.Y > Location.Y) != (LastPoint.Y > Location.Y))
+			{
+				const float X = LastPoint.X + (Location.Y - LastPoint.Y) / (Point.Y - LastPoint.Y) * (Point.X - LastPoint.X);
+				bInside ^= Location.X < X;
+			}
+			LastPoint = Point;
+		}
+
+		return bInside;
+	}
+
+	/** Tests every side and both caps with the same crossing rules as FindSegmentCrossings, but without the sector walk and the box culling */
+	TArray<FPolygonAreaCrossing> FindCrossingsBruteForce(TArrayView<const FVector2D> Polygon, const FVector& Start, const FVector& End)
+	{
+		TArray<FPolygonAreaCrossing> Crossings;
+
+		const FVector Dir = End - Start;
+		const FVector2D Start2D(Start);
+		const FVector2D Dir2D(Dir);
+
+		if (Dir.Z != 0.f)
+		{
+			for (const float CapZ : { TestVerticalExtent.Min, TestVerticalExtent.Max })
+			{
+				const float Time = (CapZ - Start.Z) / Dir.Z;
+				if (Time >= 0.f && Time <= 1.f && IsInsideBruteForce(Polygon, Start2D + Dir2D * Time))
+				{
+					Crossings.Add({ 0, Time, Start + Dir * Time, INDEX_NONE, (CapZ == TestVerticalExtent.Min) == (Dir.Z > 0.f) });
+				}
+			}
+		}
+
+		if (!Dir2D.IsNearlyZero())
+		{
+			for (int32 SideIdx = 0; SideIdx < Polygon.Num(); SideIdx++)
+			{
+				const FVector2D& SideBegin = Polygon[SideIdx];
+				const FVector2D SideDir = Polygon[(SideIdx + 1) % Polygon.Num()] - SideBegin;
+
+				const float Denom = Dir2D ^ SideDir;
+				if (FMath::IsNearlyZero(Denom)) continue;
+
+				const FVector2D ToSide = SideBegin - Start2D;
+				const float Time = (ToSide ^ SideDir) / Denom;
+				const float SideTime = (ToSide ^ Dir2D) / Denom;
+				if (Time < 0.f || Time > 1.f || SideTime < 0.f || SideTime >= 1.f) continue;
+
+				const float Z = Start.Z + Dir.Z * Time;
+				if (Z < TestVerticalExtent.Min || Z > TestVerticalExtent.Max) continue;
+
+				Crossings.Add({ 0, Time, Start + Dir * Time, SideIdx, (SideDir ^ Dir2D) > 0.f });
+			}
+		}
+
+		Algo::SortBy(Crossings, &FPolygonAreaCrossing::Time);
+		return Crossings;
+	}
+
+	/** Distance from the Location to the closest side, independent of the sector search */
+	float FindSideDistanceBruteForce(TArrayView<const FVector2D> Polygon, const FVector2D& Location)
+	{
+		float MinDistSqr = TNumericLimits<float>::Max();
+
+		FVector2D LastPoint = Polygon.Last();
+		for (const FVector2D& Point : Polygon)
+		{
+			MinDistSqr = FMath::Min(MinDistSqr, FVector2D::DistSquared(FMath::ClosestPointOnSegment2D(Location, LastPoint, Point), Location));
+			LastPoint = Point;
+		}
+
+		return FMath::Sqrt(MinDistSqr);
+	}
+
+	FString DescribeCrossings(TArrayView<const FPolygonAreaCrossing> Crossings)
+	{
+		FString Description;
+		for (const FPolygonAreaCrossing& Crossing : Crossings)
+		{
+			Description += FString::Printf(TEXT("[side %d at %.4f, %s] "), Crossing.SideIndex, Crossing.Time, Crossing.bEntering ? TEXT("entering") : TEXT("leaving"));
+		}
+		return Description;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPolygonAreaCrossingTest, "SFXUtilities.Areas.SegmentCrossings",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+/**
+ * Checks FindSegmentCrossings against testing every side of the polygon:
+ * hand-made segments through the origin, through and touching vertices and through the caps of a fixed polygon,
+ * then random segments (a third of them on lines through the origin) over random star-shaped polygons
+ */
+bool FPolygonAreaCrossingTest::RunTest(const FString& Parameters)
+{
+	auto CompareCrossings = [this](const FString& What, TArrayView<const FPolygonAreaCrossing> Crossings, TArrayView<const FPolygonAreaCrossing> Expected)
+	{
+		bool bSame = Crossings.Num() == Expected.Num();
+		for (int32 i = 0; bSame && i < Crossings.Num(); i++)
+		{
+			bSame = Crossings[i].SideIndex == Expected[i].SideIndex
+				&& Crossings[i].bEntering == Expected[i].bEntering
+				&& FMath::IsNearlyEqual(Crossings[i].Time, Expected[i].Time, KINDA_SMALL_NUMBER);
+		}
+
+		if (!bSame)
+		{
+			AddError(FString::Printf(TEXT("%s: found %s, brute force found %s"), *What, *DescribeCrossings(Crossings), *DescribeCrossings(Expected)));
+		}
+		return bSame;
+	};
+
+	const TArray<FVector2D> FixedPolygon = MakeFixedPolygon();
+	UPolygonArea2DComponent* FixedArea = MakeArea(FixedPolygon);
+	if (!TestNotNull(TEXT("Fixed polygon is star-shaped"), FixedArea)) return false;
+
+	for (const FFixedSegment& Segment : MakeFixedSegments())
+	{
+		TArray<FPolygonAreaCrossing> Crossings;
+		FixedArea->FindSegmentCrossings(Segment.Start, Segment.End, Crossings);
+
+		CompareCrossings(Segment.Name, Crossings, FindCrossingsBruteForce(FixedPolygon, Segment.Start, Segment.End));
+
+		if (!TestEqual(FString::Printf(TEXT("%s: number of crossings"), Segment.Name), Crossings.Num(), Segment.Crossings.Num())) continue;
+
+		for (int32 i = 0; i < Crossings.Num(); i++)
+		{
+			TestEqual(FString::Printf(TEXT("%s: side of crossing %d"), Segment.Name, i), Crossings[i].SideIndex, Segment.Crossings[i].SideIndex);
+			if (!Segment.bTouching)
+			{
+				TestEqual(FString::Printf(TEXT("%s: direction of crossing %d"), Segment.Name, i), Crossings[i].bEntering, Segment.Crossings[i].bEntering);
+			}
+		}
+	}
+
+	FRandomStream Random(RandomSeed);
+	int32 NumMismatches = 0;
+
+	for (int32 PolygonIdx = 0; PolygonIdx < NumRandomPolygons; PolygonIdx++)
+	{
+		const TArray<FVector2D> Polygon = TestUtils::MakeStarShapedPolygon(Random, Random.RandRange(4, 64), 200.f, 1000.f);
+		UPolygonArea2DComponent* Area = MakeArea(Polygon);
+		if (!TestNotNull(TEXT("Random polygon is star-shaped"), Area)) continue;
+
+		for (int32 SegmentIdx = 0; SegmentIdx < NumRandomSegments; SegmentIdx++)
+		{
+			const FVector End(Random.FRandRange(-1500.f, 1500.f), Random.FRandRange(-1500.f, 1500.f), Random.FRandRange(-200.f, 500.f));
+			const FVector Start = (SegmentIdx % 3 == 0)
+				? FVector(FVector2D(End) * -Random.FRandRange(0.f, 1.5f), Random.FRandRange(-200.f, 500.f))
+				: FVector(Random.FRandRange(-1500.f, 1500.f), Random.FRandRange(-1500.f, 1500.f), Random.FRandRange(-200.f, 500.f));
+
+			TArray<FPolygonAreaCrossing> Crossings;
+			Area->FindSegmentCrossings(Start, End, Crossings);
+
+			const FString What = FString::Printf(TEXT("Polygon %d, segment %s -> %s"), PolygonIdx, *Start.ToString(), *End.ToString());
+			NumMismatches += CompareCrossings(What, Crossings, FindCrossingsBruteForce(Polygon, Start, End)) ? 0 : 1;
+		}
+	}
+
+	AddInfo(FString::Printf(TEXT("%d of %d random segments differ from brute force"), NumMismatches, NumRandomPolygons * NumRandomSegments));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPolygonAreaOriginDistanceTest, "SFXUtilities.Areas.OriginSignedDistance",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+/** Checks the signed distance FindClosestPoint returns at the area origin, which no polygon sector contains */
+bool FPolygonAreaOriginDistanceTest::RunTest(const FString& Parameters)
+{
+	auto TestOriginDistance = [this](const FString& What, const TArray<FVector2D>& Polygon)
+	{
+		UPolygonArea2DComponent* Area = MakeArea(Polygon);
+		if (!TestNotNull(FString::Printf(TEXT("%s: is star-shaped"), *What), Area)) return;
+
+		const float Z = TestVerticalExtent.Interpolate(0.5f);
+		const float ExpectedDepth = FMath::Min3(FindSideDistanceBruteForce(Polygon, FVector2D::ZeroVector), Z - TestVerticalExtent.Min, TestVerticalExtent.Max - Z);
+
+		float SignedDistance;
+		const FVector ClosestPoint = Area->FindClosestPoint(FVector(0.f, 0.f, Z), SignedDistance);
+
+		TestEqual(FString::Printf(TEXT("%s: closest point"), *What), ClosestPoint, FVector(0.f, 0.f, Z));
+		TestEqual(FString::Printf(TEXT("%s: signed distance"), *What), SignedDistance, -ExpectedDepth, KINDA_SMALL_NUMBER * ExpectedDepth);
+	};
+
+	TestOriginDistance(TEXT("Fixed polygon"), MakeFixedPolygon());
+
+	FRandomStream Random(RandomSeed);
+	for (int32 PolygonIdx = 0; PolygonIdx < NumRandomPolygons; PolygonIdx++)
+	{
+		TestOriginDistance(FString::Printf(TEXT("Polygon %d"), PolygonIdx), TestUtils::MakeStarShapedPolygon(Random, Random.RandRange(4, 64), 50.f, 1000.f));
+	}
+
+	return true;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace TestUtils
+{
+	/** Returns random counter-clockwise polygon, which every side is visible from the origin */
+	inline TArray<FVector2D> MakeStarShapedPolygon(FRandomStream& Random, int32 NumPoints, float MinRadius, float MaxRadius)
+	{
+		TArray<FVector2D> Points;
+		Points.Reserve(NumPoints);
+
+		// Jittered angles never get closer than a half step, so each side spans less than PI
+		const float AngleStep = 2.f * PI / NumPoints;
+		for (int32 i = 0; i < NumPoints; i++)
+		{
+			float Sin, Cos;
+			FMath::SinCos(&Sin, &Cos, (i + Random.FRandRange(-0.25f, 0.25f)) * AngleStep);
+			Points.Add(FVector2D(Cos, Sin) * Random.FRandRange(MinRadius, MaxRadius));
+		}
+
+		return Points;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,179 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SFXUtilities/Actors/FMODVolumetricEmitter.h"
+#include "SFXUtilities/Components/PolygonArea2DComponent.h"
+#include "SFXUtilities/Subsystems/VolumetricEmitterSubsystem.h"
+#include "SFXUtilities/Tests/PolygonAreaTestUtils.h"
+#include "SFXUtilities/Utilities/NullVolumetricAudioBackend.h"
+#include "SFXUtilities/Utilities/PolygonAreaShape.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	TAutoConsoleVariable<float> CVarTestMaxAverageUsPerEmitter(
+		TEXT("sfx.Test.MaxAverageUsPerEmitter"),
+		2.f,
+		TEXT("Volumetric emitter performance test fails if the average frame time per emitter exceeds this (microseconds)."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarTestMaxPeakUsPerEmitter(
+		TEXT("sfx.Test.MaxPeakUsPerEmitter"),
+		10.f,
+		TEXT("Volumetric emitter performance test fails if the slowest frame time per emitter exceeds this (microseconds)."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int32> CVarTestNumFrames(
+		TEXT("sfx.Test.NumFrames"),
+		300,
+		TEXT("Number of frames the volumetric emitter performance test listener walks its path."),
+		ECVF_Default);
+
+	constexpr int32 RandomSeed = 0x5F3;
+	constexpr float TestDeltaTime = 1.f / 60.f;
+	constexpr float EmitterSpacing = 4000.f;
+	constexpr float EmitterMaxRadius = 3000.f;
+
+	/** Listener walks a figure eight over the whole emitter field */
+	FVector GetListenerLocation(float Alpha, float FieldSize)
+	{
+		const float Angle = 2.f * PI * Alpha;
+		return FVector(FMath::Sin(Angle), FMath::Sin(2.f * Angle) * 0.5f, 0.f) * FieldSize * 0.5f;
+	}
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FVolumetricEmitterPerformanceTest, "SFXUtilities.Performance.VolumetricEmitters",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+void FVolumetricEmitterPerformanceTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const TCHAR* NumEmitters : { TEXT("500"), TEXT("2000"), TEXT("5000") })
+	{
+		OutBeautifiedNames.Add(FString::Printf(TEXT("%s emitters"), NumEmitters));
+		OutTestCommands.Add(NumEmitters);
+	}
+}
+
+/**
+ * Spawns emitters with random star-shaped areas in a headless world (no rendering, no audio device, no FMOD banks)
+ * and measures game thread time of the emitters and their subsystem while the listener walks a scripted path
+ * Emitters play through the null audio backend, which counts the audio calls the pipeline makes
+ */
+bool FVolumetricEmitterPerformanceTest::RunTest(const FString& Parameters)
+{
+	const int32 NumEmitters = FCString::Atoi(*Parameters);
+	const int32 NumFrames = FMath::Max(CVarTestNumFrames.GetValueOnGameThread(), 1);
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	UVolumetricEmitterSubsystem* Subsystem = World->GetSubsystem<UVolumetricEmitterSubsystem>();
+
+	TUniquePtr<FNullVolumetricAudioBackend> NewAudioBackend = MakeUnique<FNullVolumetricAudioBackend>(EmitterMaxRadius);
+	FNullVolumetricAudioBackend* AudioBackend = NewAudioBackend.Get();
+	Subsystem->SetAudioBackend(MoveTemp(NewAudioBackend));
+
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	APlayerController* Listener = World->SpawnActor<APlayerController>();
+	Listener->SetAudioListenerOverride(nullptr, FVector::ZeroVector, FRotator::ZeroRotator);
+
+	// Emitters fill a square grid, so the listener path crosses the same density for any count
+	const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumEmitters)));
+	const float FieldSize = GridSize * EmitterSpacing;
+
+	FRandomStream Random(RandomSeed);
+
+	TArray<AFMODVolumetricEmitter*> Emitters;
+	Emitters.Reserve(NumEmitters);
+	int32 NumPoints = 0;
+
+	for (int32 i = 0; i < NumEmitters; i++)
+	{
+		const FVector Location(
+			(i % GridSize + 0.5f) * EmitterSpacing - FieldSize * 0.5f,
+			(i / GridSize + 0.5f) * EmitterSpacing - FieldSize * 0.5f,
+			0.f);
+		const FTransform Transform(FRotator(0.f, Random.FRandRange(0.f, 360.f), 0.f), Location, FVector(Random.FRandRange(0.5f, 2.f)));
+
+		// Mostly small areas with a few huge ones, like real levels
+		const int32 NumAreaPoints = Random.FRand() < 0.1f ? Random.RandRange(512, 2048) : Random.RandRange(8, 64);
+		FPolygonAreaShapePtr Shape = FPolygonAreaShape::Build(TestUtils::MakeStarShapedPolygon(Random, NumAreaPoints, 200.f, 1000.f));
+		if (!TestTrue(TEXT("Generated polygon is star-shaped"), Shape.IsValid())) break;
+
+		AFMODVolumetricEmitter* Emitter = World->SpawnActorDeferred<AFMODVolumetricEmitter>(AFMODVolumetricEmitter::StaticClass(), Transform);
+		Emitter->OverrideMaxRadius(EmitterMaxRadius);
+		Emitter->GetArea()->InitializeShape(Shape->Points, Shape->MinBox, Shape->MaxBox);
+		Emitter->FinishSpawning(Transform);
+
+		Emitter->SetListener(Listener);
+
+		Emitters.Add(Emitter);
+		NumPoints += NumAreaPoints;
+	}
+
+	// Activation is time-sliced in game, here all emitters are activated before measuring
+	Subsystem->FlushEmitterActivations();
+
+	// Frames are driven below, so only the measured code runs
+	for (AFMODVolumetricEmitter* Emitter : Emitters)
+	{
+		Emitter->SetActorTickEnabled(false);
+	}
+
+	// Only the calls made while the listener walks are measured
+	AudioBackend->ResetCallCounts();
+
+	double TotalSeconds = 0.0;
+	double PeakSeconds = 0.0;
+
+	for (int32 Frame = 0; Frame < NumFrames; Frame++)
+	{
+		Listener->SetAudioListenerOverride(nullptr, GetListenerLocation(static_cast<float>(Frame) / NumFrames, FieldSize), FRotator::ZeroRotator);
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		for (AFMODVolumetricEmitter* Emitter : Emitters)
+		{
+			Emitter->Tick(TestDeltaTime);
+		}
+		Subsystem->Tick(TestDeltaTime);
+
+		const double FrameSeconds = FPlatformTime::Seconds() - StartTime;
+		TotalSeconds += FrameSeconds;
+		PeakSeconds = FMath::Max(PeakSeconds, FrameSeconds);
+	}
+
+	const FVolumetricAudioCallCounts CallCounts = AudioBackend->GetCallCounts();
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	const double AverageUs = TotalSeconds * 1000000.0 / NumFrames;
+	const double PeakUs = PeakSeconds * 1000000.0;
+
+	AddInfo(FString::Printf(TEXT("%d emitters, %d points, %d frames: average %.3f ms, peak %.3f ms per frame"),
+		Emitters.Num(), NumPoints, NumFrames, AverageUs / 1000.0, PeakUs / 1000.0));
+	AddInfo(FString::Printf(TEXT("Audio backend: %s, %.1f calls per frame"), *CallCounts.ToString(), static_cast<float>(CallCounts.GetTotal()) / NumFrames));
+
+	const double MaxAverageUs = CVarTestMaxAverageUsPerEmitter.GetValueOnGameThread() * NumEmitters;
+	const double MaxPeakUs = CVarTestMaxPeakUsPerEmitter.GetValueOnGameThread() * NumEmitters;
+
+	TestTrue(FString::Printf(TEXT("Average frame time %.3f ms is within %.3f ms"), AverageUs / 1000.0, MaxAverageUs / 1000.0), AverageUs <= MaxAverageUs);
+	TestTrue(FString::Printf(TEXT("Peak frame time %.3f ms is within %.3f ms"), PeakUs / 1000.0, MaxPeakUs / 1000.0), PeakUs <= MaxPeakUs);
+
+	return true;
+}
+
+#endif
\ No newline at end of file
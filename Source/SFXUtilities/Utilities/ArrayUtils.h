@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Containers/Array.h"
+#include "Containers/ArrayView.h"
 
 namespace Utils
 {
@@ -19,9 +20,20 @@ namespace Utils
 			return (Index == 0) ? Array.Num() - 1 : Index - 1;
 		}
 
-		const TArray<T>& Array;
+		/** Maps any Index, including negative ones, into the array */
+		int32 Wrap(int32 Index) const
+		{
+			check(Array.Num() > 0);
+			const int32 Wrapped = Index % Array.Num();
+			return (Wrapped < 0) ? Wrapped + Array.Num() : Wrapped;
+		}
+
+		TArrayView<const T> Array;
 	};
 
 	template<class T>
 	TCyclicArray<T> GetCyclic(const TArray<T>& Array) { return TCyclicArray<T>{ Array }; }
+
+	template<class T>
+	TCyclicArray<T> GetCyclic(TArrayView<const T> Array) { return TCyclicArray<T>{ Array }; }
 }
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "DebugDrawUtils.h"
+
+#if ENABLE_DRAW_DEBUG
+#include "SFXUtilities/Actors/FMODVolumetricEmitter.h"
+#include "SFXUtilities/Components/PolygonArea2DComponent.h"
+#include "SFXUtilities/Subsystems/PolygonAreaSubsystem.h"
+#include "SFXUtilities/Subsystems/VolumetricEmitterSubsystem.h"
+
+#include "FMODAudioComponent.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarDrawAreas(
+		TEXT("sfx.Debug.DrawAreas"),
+		0,
+		TEXT("Draws polygon outlines of the areas near the view."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int32> CVarDrawBoxes(
+		TEXT("sfx.Debug.DrawBoxes"),
+		0,
+		TEXT("Draws inscribed (green) and bounding (red) boxes of the areas near the view."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int32> CVarDrawRadii(
+		TEXT("sfx.Debug.DrawRadii"),
+		0,
+		TEXT("Draws max radius spheres of the volumetric emitters near the view."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int32> CVarDrawQueries(
+		TEXT("sfx.Debug.DrawQueries"),
+		0,
+		TEXT("Draws segments from the listener to the closest area points of the volumetric emitters in range."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarDrawDistance(
+		TEXT("sfx.Debug.DrawDistance"),
+		20000.f,
+		TEXT("Areas and emitter spheres further from the view are not drawn."),
+		ECVF_Default);
+
+	constexpr int32 NumSphereCircleSegments = 24;
+}
+
+namespace Utils
+{
+	namespace DebugDraw
+	{
+		void AddLine(TArray<FBatchedLine>& Lines, const FVector& Start, const FVector& End, const FLinearColor& Color, float Thickness)
+		{
+			// Zero life time lines are removed by the line batcher after one frame
+			Lines.Emplace(Start, End, Color, 0.f, Thickness, SDPG_World);
+		}
+
+		void AddBox(TArray<FBatchedLine>& Lines, const FMatrix& BoxToWorld, const FBox& Box, const FLinearColor& Color, float Thickness)
+		{
+			FVector Corners[8];
+			for (int32 Index = 0; Index < 8; Index++)
+			{
+				// Corner bits select min or max along X, Y and Z
+				const FVector Corner(
+					(Index & 1) ? Box.Max.X : Box.Min.X,
+					(Index & 2) ? Box.Max.Y : Box.Min.Y,
+					(Index & 4) ? Box.Max.Z : Box.Min.Z);
+				Corners[Index] = BoxToWorld.TransformPosition(Corner);
+			}
+
+			// Edges connect corners differing in one bit
+			for (int32 Index = 0; Index < 8; Index++)
+			{
+				for (int32 Bit = 1; Bit < 8; Bit <<= 1)
+				{
+					if ((Index & Bit) == 0)
+					{
+						AddLine(Lines, Corners[Index], Corners[Index | Bit], Color, Thickness);
+					}
+				}
+			}
+		}
+
+		void AddSphere(TArray<FBatchedLine>& Lines, const FVector& Center, float Radius, const FLinearColor& Color, float Thickness)
+		{
+			const FVector Axes[3] = { FVector::ForwardVector, FVector::RightVector, FVector::UpVector };
+
+			for (int32 Axis = 0; Axis < 3; Axis++)
+			{
+				const FVector& X = Axes[Axis];
+				const FVector& Y = Axes[(Axis + 1) % 3];
+
+				FVector LastPoint = Center + X * Radius;
+				for (int32 Segment = 1; Segment <= NumSphereCircleSegments; Segment++)
+				{
+					float Sin, Cos;
+					FMath::SinCos(&Sin, &Cos, 2.f * PI * Segment / NumSphereCircleSegments);
+
+					const FVector Point = Center + (X * Cos + Y * Sin) * Radius;
+					AddLine(Lines, LastPoint, Point, Color, Thickness);
+					LastPoint = Point;
+				}
+			}
+		}
+
+		void DrawWorld(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+		{
+			const bool bDrawAreas = CVarDrawAreas.GetValueOnGameThread() != 0;
+			const bool bDrawBoxes = CVarDrawBoxes.GetValueOnGameThread() != 0;
+			const bool bDrawRadii = CVarDrawRadii.GetValueOnGameThread() != 0;
+			const bool bDrawQueries = CVarDrawQueries.GetValueOnGameThread() != 0;
+			if (!bDrawAreas && !bDrawBoxes && !bDrawRadii && !bDrawQueries) return;
+
+			if (World == nullptr || !World->IsGameWorld() || World->LineBatcher == nullptr) return;
+
+			// Works for PIE, simulate and spectating alike, unlike the player view point
+			if (World->ViewLocationsRenderedLastFrame.Num() == 0) return;
+			const FVector& ViewLocation = World->ViewLocationsRenderedLastFrame[0];
+			const float DrawDistance = CVarDrawDistance.GetValueOnGameThread();
+
+			TArray<FBatchedLine> Lines;
+
+			if (bDrawAreas || bDrawBoxes)
+			{
+				if (const UPolygonAreaSubsystem* AreaSubsystem = World->GetSubsystem<UPolygonAreaSubsystem>())
+				{
+					TArray<UPolygonArea2DComponent*> Areas;
+					AreaSubsystem->FindAreasWithinRadius(ViewLocation, DrawDistance, Areas);
+
+					for (const UPolygonArea2DComponent* Area : Areas)
+					{
+						Area->AddDebugLines(Lines, bDrawAreas, bDrawBoxes);
+					}
+				}
+			}
+
+			if (bDrawRadii || bDrawQueries)
+			{
+				if (const UVolumetricEmitterSubsystem* EmitterSubsystem = World->GetSubsystem<UVolumetricEmitterSubsystem>())
+				{
+					EmitterSubsystem->ForEachEmitter([&](const AFMODVolumetricEmitter& Emitter)
+					{
+						const float Dist = FVector::Dist(ViewLocation, Emitter.AudioComponent->GetComponentLocation());
+						if (Dist - Emitter.GetMaxRadius() <= DrawDistance)
+						{
+							Emitter.AddDebugLines(Lines, bDrawRadii, bDrawQueries);
+						}
+					});
+				}
+			}
+
+			if (Lines.Num() > 0)
+			{
+				World->LineBatcher->DrawLines(Lines);
+			}
+		}
+	}
+}
+#endif
\ No newline at end of file
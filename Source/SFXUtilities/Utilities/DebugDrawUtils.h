@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+
+#if ENABLE_DRAW_DEBUG
+#include "Components/LineBatchComponent.h"
+
+namespace Utils
+{
+	/**
+	 * Debug pass drawing areas and volumetric emitters near the view in one line batch per frame,
+	 * enabled by the sfx.Debug.* console variables (all off by default, so nothing is drawn or collected while profiling)
+	 */
+	namespace DebugDraw
+	{
+		SFXUTILITIES_API void AddLine(TArray<FBatchedLine>& Lines, const FVector& Start, const FVector& End, const FLinearColor& Color, float Thickness);
+
+		/** Adds 12 edges of the Box transformed by the BoxToWorld matrix */
+		SFXUTILITIES_API void AddBox(TArray<FBatchedLine>& Lines, const FMatrix& BoxToWorld, const FBox& Box, const FLinearColor& Color, float Thickness);
+
+		/** Adds three great circles of the sphere */
+		SFXUTILITIES_API void AddSphere(TArray<FBatchedLine>& Lines, const FVector& Center, float Radius, const FLinearColor& Color, float Thickness);
+
+		/** Collects the debug lines of the World within sfx.Debug.DrawDistance from the view and submits them at once, runs after the actor tick */
+		SFXUTILITIES_API void DrawWorld(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	}
+}
+#endif
\ No newline at end of file
@@ -23,30 +23,12 @@ namespace Utils
 
 	ESide GetSide(const FVector2D& Point);
 	ESide NextCWSide(ESide Side);
+	void ConstrainSide(FBox2D& Box, ESide Side, const FVector2D& Point);
 	void ConstrainCorner(FBox2D& Box, const FCornerLine& Line, const FVector2D* Polygon);
 	void ConstrainCorner(FVector2D& XPlane, FVector2D& YPlane, const FVector2D& LineBegin, const FVector2D& LineEnd);
 	bool RadiusIntersection(const FVector2D& RadiusVector, const FVector2D& LineBegin, const FVector2D& LineEnd, FVector2D& OutIntersectionPoint);
 
 
-	FORCEINLINE FBox2D& operator+=(FBox2D& This, const FVector2D& Other)
-	{
-		if (This.bIsValid)
-		{
-			This.Min.X = FMath::Min(This.Min.X, Other.X);
-			This.Min.Y = FMath::Min(This.Min.Y, Other.Y);
-
-			This.Max.X = FMath::Max(This.Max.X, Other.X);
-			This.Max.Y = FMath::Max(This.Max.Y, Other.Y);
-		}
-		else
-		{
-			This.Min = This.Max = Other;
-			This.bIsValid = 1;
-		}
-
-		return This;
-	}
-
 	void Inscribe(FBox2D& Box, const FVector2D* Polygon, const int32 Num)
 	{
 		TArray<FCornerLine> CornerLines;
@@ -59,23 +41,7 @@ namespace Utils
 			{
 				const FVector2D& Point = Polygon[Index];
 				const ESide Side = GetSide(Point);
-				switch (Side)
-				{
-				case ESide::PosX:
-					Box.Max.X = FMath::Min(Box.Max.X, Point.X);
-					break;
-				case ESide::NegX:
-					Box.Min.X = FMath::Max(Box.Min.X, Point.X);
-					break;
-				case ESide::PosY:
-					Box.Max.Y = FMath::Min(Box.Max.Y, Point.Y);
-					break;
-				case ESide::NegY:
-					Box.Min.Y = FMath::Max(Box.Min.Y, Point.Y);
-					break;
-				default:
-					break;
-				}
+				ConstrainSide(Box, Side, Point);
 
 				if (Side != LastSide)
 				{
@@ -104,6 +70,20 @@ namespace Utils
 		}
 	}
 
+	void InscribePoint(FBox2D& Box, const FVector2D& Point)
+	{
+		ConstrainSide(Box, GetSide(Point), Point);
+	}
+
+	void InscribeSide(FBox2D& Box, const FVector2D& LineBegin, const FVector2D& LineEnd)
+	{
+		// A side of the star-shaped polygon crosses the ray to a corner at most once, so only corners behind it move
+		ConstrainCorner(Box.Max, Box.Max, LineBegin, LineEnd);
+		ConstrainCorner(Box.Min, Box.Max, LineBegin, LineEnd);
+		ConstrainCorner(Box.Min, Box.Min, LineBegin, LineEnd);
+		ConstrainCorner(Box.Max, Box.Min, LineBegin, LineEnd);
+	}
+
 	ESide GetSide(const FVector2D& Point)
 	{
 		const bool bNegXPosY = Point.Y > Point.X;
@@ -116,6 +96,27 @@ namespace Utils
 		return static_cast<ESide>((static_cast<unsigned int>(Side) + 1u) & 0b11u);
 	}
 
+	void ConstrainSide(FBox2D& Box, ESide Side, const FVector2D& Point)
+	{
+		switch (Side)
+		{
+		case ESide::PosX:
+			Box.Max.X = FMath::Min(Box.Max.X, Point.X);
+			break;
+		case ESide::NegX:
+			Box.Min.X = FMath::Max(Box.Min.X, Point.X);
+			break;
+		case ESide::PosY:
+			Box.Max.Y = FMath::Min(Box.Max.Y, Point.Y);
+			break;
+		case ESide::NegY:
+			Box.Min.Y = FMath::Max(Box.Min.Y, Point.Y);
+			break;
+		default:
+			break;
+		}
+	}
+
 	void ConstrainCorner(FBox2D& Box, const FCornerLine& Line, const FVector2D* Polygon)
 	{
 		const FVector2D& LineBegin = Polygon[Line.BeginIndex];
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Math/Box2D.h"
+
+namespace Utils
+{
+	FORCEINLINE FBox2D& operator+=(FBox2D& This, const FVector2D& Other)
+	{
+		if (This.bIsValid)
+		{
+			This.Min.X = FMath::Min(This.Min.X, Other.X);
+			This.Min.Y = FMath::Min(This.Min.Y, Other.Y);
+
+			This.Max.X = FMath::Max(This.Max.X, Other.X);
+			This.Max.Y = FMath::Max(This.Max.Y, Other.Y);
+		}
+		else
+		{
+			This.Min = This.Max = Other;
+			This.bIsValid = 1;
+		}
+
+		return This;
+	}
+
+	/** Shrinks the Box, which initially bounds the star-shaped Polygon, so it is inscribed in the Polygon */
+	SFXUTILITIES_API void Inscribe(FBox2D& Box, const FVector2D* Polygon, const int32 Num);
+
+	/** Shrinks the inscribed Box the same way Inscribe does for a single polygon Point, so the Point does not cut into the Box */
+	SFXUTILITIES_API void InscribePoint(FBox2D& Box, const FVector2D& Point);
+
+	/** Shrinks the inscribed Box, so none of its corners lies beyond the polygon side going from LineBegin to LineEnd */
+	SFXUTILITIES_API void InscribeSide(FBox2D& Box, const FVector2D& LineBegin, const FVector2D& LineEnd);
+}
\ No newline at end of file
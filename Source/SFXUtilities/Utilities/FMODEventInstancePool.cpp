@@ -0,0 +1,73 @@
+#include "FMODEventInstancePool.h"
+
+#include "FMODEvent.h"
+#include "FMODStudioModule.h"
+#include "fmod_studio.hpp"
+
+FFMODEventInstancePool::~FFMODEventInstancePool()
+{
+	Empty();
+}
+
+FMOD::Studio::EventInstance* FFMODEventInstancePool::Acquire(const UFMODEvent* Event)
+{
+	if (Event == nullptr) return nullptr;
+
+	if (TArray<FMOD::Studio::EventInstance*>* Instances = FreeInstances.Find(Event))
+	{
+		while (Instances->Num() > 0)
+		{
+			FMOD::Studio::EventInstance* Instance = Instances->Pop(false);
+
+			// Instances die with their bank, skip those
+			if (Instance->isValid())
+			{
+				return Instance;
+			}
+		}
+	}
+
+	FMOD::Studio::EventDescription* EventDesc = IFMODStudioModule::Get().GetEventDescription(Event, EFMODSystemContext::Runtime);
+	if (EventDesc == nullptr) return nullptr;
+
+	FMOD::Studio::EventInstance* Instance = nullptr;
+	EventDesc->createInstance(&Instance);
+	return Instance;
+}
+
+void FFMODEventInstancePool::Release(const UFMODEvent* Event, FMOD::Studio::EventInstance* Instance)
+{
+	if (Instance == nullptr || !Instance->isValid()) return;
+
+	Instance->stop(FMOD_STUDIO_STOP_IMMEDIATE);
+
+	TArray<FMOD::Studio::EventInstance*>& Instances = FreeInstances.FindOrAdd(Event);
+	if (Instances.Num() < MaxPooledPerEvent)
+	{
+		Instances.Add(Instance);
+	}
+	else
+	{
+		Instance->release();
+	}
+}
+
+void FFMODEventInstancePool::Empty()
+{
+	// Studio system may already be gone on shutdown
+	if (IFMODStudioModule::IsAvailable())
+	{
+		for (auto& Pair : FreeInstances)
+		{
+			for (FMOD::Studio::EventInstance* Instance : Pair.Value)
+			{
+				if (Instance->isValid())
+				{
+					Instance->release();
+				}
+			}
+		}
+	}
+
+	FreeInstances.Empty();
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UFMODEvent;
+
+namespace FMOD
+{
+	namespace Studio
+	{
+		class EventInstance;
+	}
+}
+
+/**
+ * Keeps stopped FMOD event instances per event, so emitters playing the same event reuse them
+ * instead of creating and releasing instances every time the listener passes by
+ */
+class SFXUTILITIES_API FFMODEventInstancePool
+{
+public:
+	~FFMODEventInstancePool();
+
+	/** Returns a stopped instance of the Event (pooled or newly created), nullptr if the event is not loaded */
+	FMOD::Studio::EventInstance* Acquire(const UFMODEvent* Event);
+
+	/** Stops the Instance and keeps it for reuse, or releases it if the event pool is full */
+	void Release(const UFMODEvent* Event, FMOD::Studio::EventInstance* Instance);
+
+	/** Releases all pooled instances */
+	void Empty();
+
+	/** Max number of stopped instances kept per event */
+	int32 MaxPooledPerEvent = 8;
+
+private:
+	TMap<const UFMODEvent*, TArray<FMOD::Studio::EventInstance*>> FreeInstances;
+};
\ No newline at end of file
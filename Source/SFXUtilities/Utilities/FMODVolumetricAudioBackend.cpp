@@ -0,0 +1,87 @@
+#include "FMODVolumetricAudioBackend.h"
+
+#include "FMODEvent.h"
+#include "FMODStudioModule.h"
+#include "FMODUtils.h"
+#include "fmod_studio.hpp"
+
+namespace
+{
+	FMOD::Studio::EventInstance* GetEventInstance(FVolumetricAudioInstance Instance)
+	{
+		check(Instance.IsValid());
+		return reinterpret_cast<FMOD::Studio::EventInstance*>(Instance.GetHandle());
+	}
+}
+
+bool FFMODVolumetricAudioBackend::GetMaxDistance(const UFMODEvent* Event, float& OutMaxDistance)
+{
+	if (Event == nullptr) return false;
+
+	FMOD::Studio::EventDescription* EventDesc = IFMODStudioModule::Get().GetEventDescription(Event, EFMODSystemContext::Auditioning);
+	if (EventDesc == nullptr) return false;
+
+	bool bIs3D = false;
+	EventDesc->is3D(&bIs3D);
+	if (!bIs3D) return false;
+
+	float MaxDistance = 0.f;
+	EventDesc->getMaximumDistance(&MaxDistance);
+	OutMaxDistance = FMODUtils::DistanceToUEScale(MaxDistance);
+
+	return true;
+}
+
+FVolumetricAudioInstance FFMODVolumetricAudioBackend::AcquireInstance(const UFMODEvent* Event)
+{
+	return FVolumetricAudioInstance(reinterpret_cast<UPTRINT>(InstancePool.Acquire(Event)));
+}
+
+void FFMODVolumetricAudioBackend::ReleaseInstance(const UFMODEvent* Event, FVolumetricAudioInstance Instance)
+{
+	InstancePool.Release(Event, GetEventInstance(Instance));
+}
+
+void FFMODVolumetricAudioBackend::SetAttenuation(FVolumetricAudioInstance Instance, float MinDistance, float MaxDistance)
+{
+	FMOD::Studio::EventInstance* EventInstance = GetEventInstance(Instance);
+	EventInstance->setProperty(FMOD_STUDIO_EVENT_PROPERTY_MINIMUM_DISTANCE, MinDistance);
+	EventInstance->setProperty(FMOD_STUDIO_EVENT_PROPERTY_MAXIMUM_DISTANCE, MaxDistance);
+}
+
+void FFMODVolumetricAudioBackend::SetParameter(FVolumetricAudioInstance Instance, FName Name, float Value)
+{
+	TArray<ANSICHAR>& Utf8Name = ParameterNames.FindOrAdd(Name);
+	if (Utf8Name.Num() == 0)
+	{
+		const FTCHARToUTF8 Converted(*Name.ToString());
+		Utf8Name.Append(Converted.Get(), Converted.Length() + 1);
+	}
+
+	GetEventInstance(Instance)->setParameterByName(Utf8Name.GetData(), Value);
+}
+
+void FFMODVolumetricAudioBackend::Set3DAttributes(FVolumetricAudioInstance Instance, const FTransform& Transform)
+{
+	FMOD_3D_ATTRIBUTES Attributes = { { 0 } };
+	FMODUtils::Assign(Attributes, Transform);
+	GetEventInstance(Instance)->set3DAttributes(&Attributes);
+}
+
+void FFMODVolumetricAudioBackend::Start(FVolumetricAudioInstance Instance)
+{
+	GetEventInstance(Instance)->start();
+}
+
+void FFMODVolumetricAudioBackend::Stop(FVolumetricAudioInstance Instance)
+{
+	GetEventInstance(Instance)->stop(FMOD_STUDIO_STOP_ALLOWFADEOUT);
+}
+
+SIZE_T FFMODVolumetricAudioBackend::GetInstanceMemory(FVolumetricAudioInstance Instance) const
+{
+	FMOD_STUDIO_MEMORY_USAGE MemoryUsage;
+	if (GetEventInstance(Instance)->getMemoryUsage(&MemoryUsage) != FMOD_OK) return 0;
+
+	return MemoryUsage.exclusive;
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SFXUtilities/Utilities/FMODEventInstancePool.h"
+#include "SFXUtilities/Utilities/VolumetricAudioBackend.h"
+
+/** Plays volumetric emitters through FMOD Studio, reusing event instances from the pool */
+class SFXUTILITIES_API FFMODVolumetricAudioBackend : public IVolumetricAudioBackend
+{
+public:
+	// Begin IVolumetricAudioBackend interface
+	bool GetMaxDistance(const UFMODEvent* Event, float& OutMaxDistance) override;
+	FVolumetricAudioInstance AcquireInstance(const UFMODEvent* Event) override;
+	void ReleaseInstance(const UFMODEvent* Event, FVolumetricAudioInstance Instance) override;
+	void SetAttenuation(FVolumetricAudioInstance Instance, float MinDistance, float MaxDistance) override;
+	void SetParameter(FVolumetricAudioInstance Instance, FName Name, float Value) override;
+	void Set3DAttributes(FVolumetricAudioInstance Instance, const FTransform& Transform) override;
+	void Start(FVolumetricAudioInstance Instance) override;
+	void Stop(FVolumetricAudioInstance Instance) override;
+	SIZE_T GetInstanceMemory(FVolumetricAudioInstance Instance) const override;
+	void SetMaxPooledPerEvent(int32 MaxPooled) override { InstancePool.MaxPooledPerEvent = MaxPooled; }
+	// End IVolumetricAudioBackend interface
+
+private:
+	FFMODEventInstancePool InstancePool;
+
+	/** Null-terminated UTF-8 parameter names, converted once instead of on every SetParameter */
+	TMap<FName, TArray<ANSICHAR>> ParameterNames;
+};
\ No newline at end of file
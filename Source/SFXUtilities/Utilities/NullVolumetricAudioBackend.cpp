@@ -0,0 +1,113 @@
+#include "NullVolumetricAudioBackend.h"
+
+int32 FVolumetricAudioCallCounts::GetTotal() const
+{
+	return GetMaxDistance + AcquireInstance + ReleaseInstance + SetAttenuation + SetParameter + Set3DAttributes + Start + Stop;
+}
+
+FString FVolumetricAudioCallCounts::ToString() const
+{
+	return FString::Printf(TEXT("%d calls (GetMaxDistance %d, Acquire %d, Release %d, SetAttenuation %d, SetParameter %d, Set3DAttributes %d, Start %d, Stop %d)"),
+		GetTotal(), GetMaxDistance, AcquireInstance, ReleaseInstance, SetAttenuation, SetParameter, Set3DAttributes, Start, Stop);
+}
+
+FNullVolumetricAudioBackend::FNullVolumetricAudioBackend(float InMaxDistance)
+	: EventMaxDistance(InMaxDistance)
+	, NextHandle(1)
+{
+}
+
+bool FNullVolumetricAudioBackend::GetMaxDistance(const UFMODEvent* Event, float& OutMaxDistance)
+{
+	CallCounts.GetMaxDistance++;
+
+	OutMaxDistance = EventMaxDistance;
+	return true;
+}
+
+FVolumetricAudioInstance FNullVolumetricAudioBackend::AcquireInstance(const UFMODEvent* Event)
+{
+	CallCounts.AcquireInstance++;
+
+	const UPTRINT Handle = NextHandle++;
+	Instances.Add(Handle);
+	return FVolumetricAudioInstance(Handle);
+}
+
+void FNullVolumetricAudioBackend::ReleaseInstance(const UFMODEvent* Event, FVolumetricAudioInstance Instance)
+{
+	CallCounts.ReleaseInstance++;
+
+	verifyf(Instances.Remove(Instance.GetHandle()) > 0, TEXT("Released instance was not acquired from this backend"));
+}
+
+void FNullVolumetricAudioBackend::SetAttenuation(FVolumetricAudioInstance Instance, float MinDistance, float MaxDistance)
+{
+	CallCounts.SetAttenuation++;
+
+	GetState(Instance);
+}
+
+void FNullVolumetricAudioBackend::SetParameter(FVolumetricAudioInstance Instance, FName Name, float Value)
+{
+	CallCounts.SetParameter++;
+
+	GetState(Instance).Parameters.Add(Name, Value);
+}
+
+void FNullVolumetricAudioBackend::Set3DAttributes(FVolumetricAudioInstance Instance, const FTransform& Transform)
+{
+	CallCounts.Set3DAttributes++;
+
+	GetState(Instance).Location = Transform.GetLocation();
+}
+
+void FNullVolumetricAudioBackend::Start(FVolumetricAudioInstance Instance)
+{
+	CallCounts.Start++;
+
+	GetState(Instance).bPlaying = true;
+}
+
+void FNullVolumetricAudioBackend::Stop(FVolumetricAudioInstance Instance)
+{
+	CallCounts.Stop++;
+
+	GetState(Instance).bPlaying = false;
+}
+
+int32 FNullVolumetricAudioBackend::GetNumPlaying() const
+{
+	int32 NumPlaying = 0;
+	for (const auto& Pair : Instances)
+	{
+		NumPlaying += Pair.Value.bPlaying ? 1 : 0;
+	}
+	return NumPlaying;
+}
+
+bool FNullVolumetricAudioBackend::GetInstanceLocation(FVolumetricAudioInstance Instance, FVector& OutLocation) const
+{
+	const FInstanceState* State = Instances.Find(Instance.GetHandle());
+	if (State == nullptr) return false;
+
+	OutLocation = State->Location;
+	return true;
+}
+
+bool FNullVolumetricAudioBackend::GetInstanceParameter(FVolumetricAudioInstance Instance, FName Name, float& OutValue) const
+{
+	const FInstanceState* State = Instances.Find(Instance.GetHandle());
+	const float* Value = State != nullptr ? State->Parameters.Find(Name) : nullptr;
+	if (Value == nullptr) return false;
+
+	OutValue = *Value;
+	return true;
+}
+
+FNullVolumetricAudioBackend::FInstanceState& FNullVolumetricAudioBackend::GetState(FVolumetricAudioInstance Instance)
+{
+	FInstanceState* State = Instances.Find(Instance.GetHandle());
+	checkf(State != nullptr, TEXT("Instance was not acquired from this backend"));
+	return *State;
+}
\ No newline at end of file
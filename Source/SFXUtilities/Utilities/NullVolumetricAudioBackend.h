@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SFXUtilities/Utilities/VolumetricAudioBackend.h"
+
+/** Number of calls of every audio backend function */
+struct FVolumetricAudioCallCounts
+{
+	int32 GetMaxDistance = 0;
+	int32 AcquireInstance = 0;
+	int32 ReleaseInstance = 0;
+	int32 SetAttenuation = 0;
+	int32 SetParameter = 0;
+	int32 Set3DAttributes = 0;
+	int32 Start = 0;
+	int32 Stop = 0;
+
+	int32 GetTotal() const;
+	FString ToString() const;
+};
+
+/**
+ * Plays nothing, but records calls and the latest state of every instance,
+ * so the emitter pipeline runs headlessly (automation tests, CI benchmarks) and its audio API traffic is measured
+ * Accepts any event (including none), every event is 3D with the same max distance
+ */
+class SFXUTILITIES_API FNullVolumetricAudioBackend : public IVolumetricAudioBackend
+{
+public:
+	explicit FNullVolumetricAudioBackend(float InMaxDistance = 3000.f);
+
+	// Begin IVolumetricAudioBackend interface
+	bool GetMaxDistance(const UFMODEvent* Event, float& OutMaxDistance) override;
+	FVolumetricAudioInstance AcquireInstance(const UFMODEvent* Event) override;
+	void ReleaseInstance(const UFMODEvent* Event, FVolumetricAudioInstance Instance) override;
+	void SetAttenuation(FVolumetricAudioInstance Instance, float MinDistance, float MaxDistance) override;
+	void SetParameter(FVolumetricAudioInstance Instance, FName Name, float Value) override;
+	void Set3DAttributes(FVolumetricAudioInstance Instance, const FTransform& Transform) override;
+	void Start(FVolumetricAudioInstance Instance) override;
+	void Stop(FVolumetricAudioInstance Instance) override;
+	// End IVolumetricAudioBackend interface
+
+	const FVolumetricAudioCallCounts& GetCallCounts() const { return CallCounts; }
+	void ResetCallCounts() { CallCounts = FVolumetricAudioCallCounts(); }
+
+	/** Returns number of acquired instances and how many of them are playing */
+	int32 GetNumInstances() const { return Instances.Num(); }
+	int32 GetNumPlaying() const;
+
+	/** Returns false if the Instance is not acquired, otherwise its latest world location */
+	bool GetInstanceLocation(FVolumetricAudioInstance Instance, FVector& OutLocation) const;
+
+	/** Returns false if the Instance is not acquired or the parameter was never set */
+	bool GetInstanceParameter(FVolumetricAudioInstance Instance, FName Name, float& OutValue) const;
+
+private:
+	struct FInstanceState
+	{
+		FVector Location = FVector::ZeroVector;
+		TMap<FName, float> Parameters;
+		bool bPlaying = false;
+	};
+
+	FInstanceState& GetState(FVolumetricAudioInstance Instance);
+
+	float EventMaxDistance;
+	UPTRINT NextHandle;
+	TMap<UPTRINT, FInstanceState> Instances;
+	FVolumetricAudioCallCounts CallCounts;
+};
\ No newline at end of file
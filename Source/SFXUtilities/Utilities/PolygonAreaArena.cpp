@@ -0,0 +1,275 @@
+#include "PolygonAreaArena.h"
+
+namespace
+{
+	// Don't bother compacting small arenas
+	constexpr int32 MinDeadPointsToCompact = 1024;
+
+	// Point query grid cell size (world units), ambient areas are usually several cells large
+	constexpr float GridCellSize = 4096.f;
+
+	// Areas overlapping more cells are kept out of the grid
+	constexpr int32 MaxCellsPerArea = 64;
+
+	FIntPoint GetGridCell(float X, float Y)
+	{
+		return FIntPoint(FMath::FloorToInt(X / GridCellSize), FMath::FloorToInt(Y / GridCellSize));
+	}
+
+	/** Returns world space bounding box of the area space Box extruded over the VerticalExtent */
+	FBox TransformBox(const FBox2D& Box, const FFloatInterval& VerticalExtent, const FTransform& Transform)
+	{
+		if (VerticalExtent.IsValid())
+		{
+			return FBox(FVector(Box.Min, VerticalExtent.Min), FVector(Box.Max, VerticalExtent.Max)).TransformBy(Transform);
+		}
+
+		// Infinitely tall areas span the whole world height
+		FBox Result = FBox(FVector(Box.Min, 0.f), FVector(Box.Max, 0.f)).TransformBy(Transform);
+		Result.Min.Z = -HALF_WORLD_MAX;
+		Result.Max.Z = HALF_WORLD_MAX;
+		return Result;
+	}
+}
+
+FPolygonAreaArena::FPolygonAreaArena()
+	: NumDeadPoints(0)
+	, NextSerial(1u)
+	, bGridDirty(false)
+{
+}
+
+FPolygonAreaHandle FPolygonAreaArena::Add(TArrayView<const FVector2D> InPoints, const FBox2D& MinBox, const FBox2D& MaxBox, const FFloatInterval& VerticalExtent, const FTransform& Transform)
+{
+	int32 SlotIndex;
+	if (FreeSlots.Num() > 0)
+	{
+		SlotIndex = FreeSlots.Pop(false);
+	}
+	else
+	{
+		SlotIndex = Slots.AddUninitialized();
+	}
+
+	FSlot& Slot = Slots[SlotIndex];
+	Slot.FirstPoint = Points.Num();
+	Slot.NumPoints = InPoints.Num();
+	Slot.DenseIndex = Bounds.Add({ MinBox, MaxBox, VerticalExtent, TransformBox(MaxBox, VerticalExtent, Transform) });
+	Slot.Serial = NextSerial++;
+
+	DenseSlots.Add(SlotIndex);
+	Points.Append(InPoints.GetData(), InPoints.Num());
+
+	bGridDirty = true;
+
+	FPolygonAreaHandle Handle;
+	Handle.Index = SlotIndex;
+	Handle.Serial = Slot.Serial;
+	return Handle;
+}
+
+void FPolygonAreaArena::Remove(FPolygonAreaHandle Handle)
+{
+	if (!IsValid(Handle)) return;
+
+	FSlot& Slot = Slots[Handle.Index];
+
+	// Keep bounds dense: move the last bounds to the freed place
+	const int32 DenseIndex = Slot.DenseIndex;
+	const int32 LastDenseIndex = Bounds.Num() - 1;
+	if (DenseIndex != LastDenseIndex)
+	{
+		Slots[DenseSlots[LastDenseIndex]].DenseIndex = DenseIndex;
+	}
+	Bounds.RemoveAtSwap(DenseIndex, 1, false);
+	DenseSlots.RemoveAtSwap(DenseIndex, 1, false);
+
+	NumDeadPoints += Slot.NumPoints;
+
+	Slot.DenseIndex = INDEX_NONE;
+	Slot.Serial = 0u;
+	FreeSlots.Add(Handle.Index);
+
+	bGridDirty = true;
+}
+
+void FPolygonAreaArena::Update(FPolygonAreaHandle Handle, TArrayView<const FVector2D> InPoints, const FBox2D& MinBox, const FBox2D& MaxBox, const FFloatInterval& VerticalExtent, const FTransform& Transform)
+{
+	checkf(IsValid(Handle), TEXT("Invalid FPolygonAreaHandle"));
+	FSlot& Slot = Slots[Handle.Index];
+
+	if (Slot.NumPoints == InPoints.Num())
+	{
+		// Deformed polygon fits in place
+		FMemory::Memcpy(Points.GetData() + Slot.FirstPoint, InPoints.GetData(), InPoints.Num() * sizeof(FVector2D));
+	}
+	else
+	{
+		NumDeadPoints += Slot.NumPoints;
+
+		Slot.FirstPoint = Points.Num();
+		Slot.NumPoints = InPoints.Num();
+		Points.Append(InPoints.GetData(), InPoints.Num());
+	}
+
+	Bounds[Slot.DenseIndex] = { MinBox, MaxBox, VerticalExtent, TransformBox(MaxBox, VerticalExtent, Transform) };
+	bGridDirty = true;
+}
+
+bool FPolygonAreaArena::IsValid(FPolygonAreaHandle Handle) const
+{
+	return Slots.IsValidIndex(Handle.Index) && Slots[Handle.Index].Serial == Handle.Serial;
+}
+
+TArrayView<const FVector2D> FPolygonAreaArena::GetPoints(FPolygonAreaHandle Handle) const
+{
+	const FSlot& Slot = GetSlot(Handle);
+	return TArrayView<const FVector2D>(Points.GetData() + Slot.FirstPoint, Slot.NumPoints);
+}
+
+const FPolygonAreaBounds& FPolygonAreaArena::GetBounds(FPolygonAreaHandle Handle) const
+{
+	return Bounds[GetSlot(Handle).DenseIndex];
+}
+
+void FPolygonAreaArena::SetTransform(FPolygonAreaHandle Handle, const FTransform& Transform)
+{
+	FPolygonAreaBounds& AreaBounds = Bounds[GetSlot(Handle).DenseIndex];
+	AreaBounds.WorldBox = TransformBox(AreaBounds.MaxBox, AreaBounds.VerticalExtent, Transform);
+	bGridDirty = true;
+}
+
+void FPolygonAreaArena::SetVerticalExtent(FPolygonAreaHandle Handle, const FFloatInterval& VerticalExtent, const FTransform& Transform)
+{
+	FPolygonAreaBounds& AreaBounds = Bounds[GetSlot(Handle).DenseIndex];
+	AreaBounds.VerticalExtent = VerticalExtent;
+	AreaBounds.WorldBox = TransformBox(AreaBounds.MaxBox, VerticalExtent, Transform);
+}
+
+void FPolygonAreaArena::FindWithinRadius(const FVector& Location, float Radius, TArray<FPolygonAreaHandle>& OutHandles) const
+{
+	const float RadiusSqr = Radius * Radius;
+
+	for (int32 DenseIndex = 0; DenseIndex < Bounds.Num(); DenseIndex++)
+	{
+		// Areas on other floors are culled by their height too
+		if (Bounds[DenseIndex].WorldBox.ComputeSquaredDistanceToPoint(Location) <= RadiusSqr)
+		{
+			OutHandles.Add(GetDenseHandle(DenseIndex));
+		}
+	}
+}
+
+void FPolygonAreaArena::FindContaining(const FVector& Location, TArray<FPolygonAreaHandle>& OutHandles)
+{
+	if (bGridDirty)
+	{
+		BuildGrid();
+	}
+
+	auto CheckArea = [this, &Location, &OutHandles](int32 DenseIndex)
+	{
+		if (Bounds[DenseIndex].WorldBox.IsInsideOrOn(Location))
+		{
+			OutHandles.Add(GetDenseHandle(DenseIndex));
+		}
+	};
+
+	if (const TArray<int32>* Cell = GridCells.Find(GetGridCell(Location.X, Location.Y)))
+	{
+		for (int32 DenseIndex : *Cell)
+		{
+			CheckArea(DenseIndex);
+		}
+	}
+
+	for (int32 DenseIndex : LargeAreas)
+	{
+		CheckArea(DenseIndex);
+	}
+}
+
+bool FPolygonAreaArena::IsCompactionNeeded() const
+{
+	return NumDeadPoints >= MinDeadPointsToCompact && NumDeadPoints > GetNumPoints();
+}
+
+void FPolygonAreaArena::Compact()
+{
+	if (NumDeadPoints == 0) return;
+
+	TArray<FVector2D> PackedPoints;
+	PackedPoints.Reserve(GetNumPoints());
+
+	// Pack in the bounds order, so linear scans over bounds also walk the points forward
+	for (int32 SlotIndex : DenseSlots)
+	{
+		FSlot& Slot = Slots[SlotIndex];
+		const int32 FirstPoint = PackedPoints.Num();
+		PackedPoints.Append(Points.GetData() + Slot.FirstPoint, Slot.NumPoints);
+		Slot.FirstPoint = FirstPoint;
+	}
+
+	Points = MoveTemp(PackedPoints);
+	NumDeadPoints = 0;
+}
+
+SIZE_T FPolygonAreaArena::GetAllocatedSize() const
+{
+	SIZE_T Size = Points.GetAllocatedSize() + Bounds.GetAllocatedSize() + DenseSlots.GetAllocatedSize()
+		+ Slots.GetAllocatedSize() + FreeSlots.GetAllocatedSize() + LargeAreas.GetAllocatedSize()
+		+ GridCells.GetAllocatedSize();
+
+	for (const TPair<FIntPoint, TArray<int32>>& Cell : GridCells)
+	{
+		Size += Cell.Value.GetAllocatedSize();
+	}
+
+	return Size;
+}
+
+const FPolygonAreaArena::FSlot& FPolygonAreaArena::GetSlot(FPolygonAreaHandle Handle) const
+{
+	checkf(IsValid(Handle), TEXT("Invalid FPolygonAreaHandle"));
+	return Slots[Handle.Index];
+}
+
+FPolygonAreaHandle FPolygonAreaArena::GetDenseHandle(int32 DenseIndex) const
+{
+	const int32 SlotIndex = DenseSlots[DenseIndex];
+
+	FPolygonAreaHandle Handle;
+	Handle.Index = SlotIndex;
+	Handle.Serial = Slots[SlotIndex].Serial;
+	return Handle;
+}
+
+void FPolygonAreaArena::BuildGrid()
+{
+	// Cell arrays are dropped too, areas rarely change often enough for that to matter
+	GridCells.Reset();
+	LargeAreas.Reset();
+
+	for (int32 DenseIndex = 0; DenseIndex < Bounds.Num(); DenseIndex++)
+	{
+		const FBox& WorldBox = Bounds[DenseIndex].WorldBox;
+		const FIntPoint MinCell = GetGridCell(WorldBox.Min.X, WorldBox.Min.Y);
+		const FIntPoint MaxCell = GetGridCell(WorldBox.Max.X, WorldBox.Max.Y);
+
+		if ((MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1) > MaxCellsPerArea)
+		{
+			LargeAreas.Add(DenseIndex);
+			continue;
+		}
+
+		for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+			{
+				GridCells.FindOrAdd(FIntPoint(X, Y)).Add(DenseIndex);
+			}
+		}
+	}
+
+	bGridDirty = false;
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/Box2D.h"
+#include "Math/Interval.h"
+
+/** Stable reference to the area stored in the FPolygonAreaArena */
+struct FPolygonAreaHandle
+{
+	FPolygonAreaHandle()
+		: Index(INDEX_NONE)
+		, Serial(0u)
+	{}
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	void Invalidate() { *this = FPolygonAreaHandle(); }
+
+	int32 GetIndex() const { return Index; }
+
+	bool operator==(const FPolygonAreaHandle& Other) const { return Index == Other.Index && Serial == Other.Serial; }
+	bool operator!=(const FPolygonAreaHandle& Other) const { return !(*this == Other); }
+
+private:
+	friend class FPolygonAreaArena;
+
+	int32 Index;
+	uint32 Serial;
+};
+
+/** Bounds of the area, packed contiguously in the FPolygonAreaArena for linear scans */
+struct FPolygonAreaBounds
+{
+	FBox2D MinBox; // Box inscribed in the polygon (area space)
+	FBox2D MaxBox; // Bounding box of the polygon (area space)
+	FFloatInterval VerticalExtent; // Height interval of the area (area space, invalid if the area is infinitely tall)
+	FBox WorldBox; // Bounding box of the transformed MaxBox extruded over the VerticalExtent (world space)
+};
+
+/**
+ * Packs vertices and bounds of many polygon areas into contiguous arrays
+ * Areas are referenced by handles, which stay valid until the area is removed, even if the arena is compacted
+ * Point views returned by the arena are invalidated by Add and Compact
+ */
+class SFXUTILITIES_API FPolygonAreaArena
+{
+public:
+	FPolygonAreaArena();
+
+	FPolygonAreaHandle Add(TArrayView<const FVector2D> InPoints, const FBox2D& MinBox, const FBox2D& MaxBox, const FFloatInterval& VerticalExtent, const FTransform& Transform);
+	void Remove(FPolygonAreaHandle Handle);
+
+	/** Replaces the area polygon and bounds, keeping the Handle valid */
+	void Update(FPolygonAreaHandle Handle, TArrayView<const FVector2D> InPoints, const FBox2D& MinBox, const FBox2D& MaxBox, const FFloatInterval& VerticalExtent, const FTransform& Transform);
+	bool IsValid(FPolygonAreaHandle Handle) const;
+
+	TArrayView<const FVector2D> GetPoints(FPolygonAreaHandle Handle) const;
+	const FPolygonAreaBounds& GetBounds(FPolygonAreaHandle Handle) const;
+	void SetTransform(FPolygonAreaHandle Handle, const FTransform& Transform);
+	void SetVerticalExtent(FPolygonAreaHandle Handle, const FFloatInterval& VerticalExtent, const FTransform& Transform);
+
+	/** Linearly scans packed bounds and collects the areas, which WorldBox is within Radius from the world Location */
+	void FindWithinRadius(const FVector& Location, float Radius, TArray<FPolygonAreaHandle>& OutHandles) const;
+
+	/** Collects the areas, which WorldBox contains the world Location, looking only at the grid cell of the Location (rebuilds the grid if areas have changed) */
+	void FindContaining(const FVector& Location, TArray<FPolygonAreaHandle>& OutHandles);
+
+	/** Returns true if dead points take enough space to be worth compacting */
+	bool IsCompactionNeeded() const;
+
+	/** Removes dead points, packing live ones in the order of the bounds array */
+	void Compact();
+
+	int32 Num() const { return Bounds.Num(); }
+	int32 GetNumPoints() const { return Points.Num() - NumDeadPoints; }
+
+	/** Returns heap memory used by the packed arrays and the point query grid, including dead points */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FSlot
+	{
+		int32 FirstPoint;
+		int32 NumPoints;
+		int32 DenseIndex; // Index in the Bounds and DenseSlots arrays (INDEX_NONE if free)
+		uint32 Serial;
+	};
+
+	const FSlot& GetSlot(FPolygonAreaHandle Handle) const;
+	FPolygonAreaHandle GetDenseHandle(int32 DenseIndex) const;
+
+	/** Puts dense indices of the areas into the grid cells overlapped by their world boxes */
+	void BuildGrid();
+
+	TArray<FVector2D> Points;
+	TArray<FPolygonAreaBounds> Bounds;
+	TArray<int32> DenseSlots; // Slot index for each Bounds element
+	TArray<FSlot> Slots;
+	TArray<int32> FreeSlots;
+	int32 NumDeadPoints;
+	uint32 NextSerial;
+
+	/** Uniform 2D grid over the world boxes, built on demand for point queries */
+	TMap<FIntPoint, TArray<int32>> GridCells;
+	TArray<int32> LargeAreas; // Areas overlapping too many cells are checked for every point
+	bool bGridDirty;
+};
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "PolygonAreaShape.h"
+
+#include "SFXUtilities/SFXUtilities.h"
+#include "SFXUtilities/Utilities/FBoxUtils.h"
+#include "SFXUtilities/Utilities/PolygonSimplification.h"
+
+namespace
+{
+	// Polygons this small are already cheap to query, no need to simplify them further
+	constexpr int32 MinLevelPoints = 32;
+
+	// Every level keeps about this fraction of the previous level points
+	constexpr float LevelReduction = 0.25f;
+
+	/**
+	 * Graham scan of the star-shaped Points, which are already sorted by angle around the origin inside them
+	 * Hull keeps the counter-clockwise order around the origin, so it is searched the same way as the polygon
+	 */
+	void BuildConvexHull(TArrayView<const FVector2D> Points, TArray<FVector2D>& OutHull)
+	{
+		OutHull.Reset(Points.Num());
+		if (Points.Num() < 3) return;
+
+		// Rightmost point is always on the hull
+		int32 StartIdx = 0;
+		for (int32 Idx = 1; Idx < Points.Num(); Idx++)
+		{
+			if (Points[Idx].X > Points[StartIdx].X)
+			{
+				StartIdx = Idx;
+			}
+		}
+
+		for (int32 Offset = 0; Offset <= Points.Num(); Offset++)
+		{
+			const FVector2D& Point = Points[(StartIdx + Offset) % Points.Num()];
+
+			// Points making a right turn or going straight are inside the hull
+			while (OutHull.Num() >= 2 && ((OutHull.Last() - OutHull.Last(1)) ^ (Point - OutHull.Last())) <= 0.f)
+			{
+				OutHull.Pop(false);
+			}
+
+			// Walk ends back at the start point, which is only used to pop the last concave points
+			if (Offset < Points.Num())
+			{
+				OutHull.Add(Point);
+			}
+		}
+	}
+}
+
+FPolygonAreaShapePtr FPolygonAreaShape::Build(TArray<FVector2D> Points)
+{
+	if (!IsStarShaped(Points)) return nullptr;
+
+	SFX_LLM_SCOPE();
+
+	TSharedRef<FPolygonAreaShape, ESPMode::ThreadSafe> Shape = MakeShared<FPolygonAreaShape, ESPMode::ThreadSafe>();
+	Shape->Points = MoveTemp(Points);
+	Shape->MaxBox = FBox2D(Shape->Points.GetData(), Shape->Points.Num());
+	Shape->MinBox = Shape->MaxBox;
+
+	Utils::Inscribe(Shape->MinBox, Shape->Points.GetData(), Shape->Points.Num());
+
+	Shape->BuildLevels();
+
+	return Shape;
+}
+
+bool FPolygonAreaShape::IsStarShaped(TArrayView<const FVector2D> Points)
+{
+	if (Points.Num() < 3) return false;
+
+	float TotalAngle = 0.f;
+
+	FVector2D LastPoint = Points.Last();
+	for (const FVector2D& Point : Points)
+	{
+		const float Cross = LastPoint ^ Point;
+		if (Cross <= 0.f) return false;
+
+		TotalAngle += FMath::Atan2(Cross, LastPoint | Point);
+		LastPoint = Point;
+	}
+
+	// Sides must wind around the origin exactly once
+	return FMath::IsNearlyEqual(TotalAngle, 2.f * PI, 1.e-3f);
+}
+
+void FPolygonAreaShape::BuildLevels()
+{
+	Levels.Reset();
+
+	BuildConvexHull(Points, Hull);
+
+	TArrayView<const FVector2D> Source = Points;
+	float SourceError = 0.f;
+
+	while (Source.Num() > MinLevelPoints)
+	{
+		const int32 TargetNum = FMath::Max(MinLevelPoints, FMath::FloorToInt(Source.Num() * LevelReduction));
+
+		FPolygonAreaLevel Level;
+		const float Error = Utils::PolygonSimplification::Simplify(Source, TargetNum, MAX_FLT, 0.f, Level.Points);
+
+		if (Level.Points.Num() * 4 > Source.Num() * 3)
+		{
+			// Star-shape constraint does not let the polygon get much simpler
+			break;
+		}
+
+		// Errors of consecutive simplifications add up
+		Level.MaxError = SourceError + Error;
+		SourceError = Level.MaxError;
+
+		BuildConvexHull(Level.Points, Level.Hull);
+
+		Levels.Add(MoveTemp(Level));
+		Source = Levels.Last().Points;
+	}
+}
+
+SIZE_T FPolygonAreaShape::GetAllocatedSize() const
+{
+	SIZE_T Size = Points.GetAllocatedSize() + Hull.GetAllocatedSize() + Levels.GetAllocatedSize();
+	for (const FPolygonAreaLevel& Level : Levels)
+	{
+		Size += Level.Points.GetAllocatedSize() + Level.Hull.GetAllocatedSize();
+	}
+	return Size;
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/Box2D.h"
+
+struct FPolygonAreaShape;
+
+using FPolygonAreaShapePtr = TSharedPtr<const FPolygonAreaShape, ESPMode::ThreadSafe>;
+
+/** Simplified polygon used for distant listeners */
+struct FPolygonAreaLevel
+{
+	TArray<FVector2D> Points;
+	TArray<FVector2D> Hull; // Convex hull of the Points, counter-clockwise around the origin
+	float MaxError; // Conservative max distance between this level and the original boundary
+};
+
+/**
+ * Immutable snapshot of the area polygon with its bounds
+ * Published snapshots are never modified, so readers on any thread may keep one while a new one is built
+ */
+struct SFXUTILITIES_API FPolygonAreaShape
+{
+	TArray<FVector2D> Points;
+	FBox2D MinBox; // Box inscribed in the polygon
+	FBox2D MaxBox; // Bounding box of the polygon
+
+	/** Convex hull of the Points, counter-clockwise around the origin (empty until the Levels are built) */
+	TArray<FVector2D> Hull;
+
+	/** Progressively simplified polygons, from the finest to the coarsest (the original Points are not included) */
+	TArray<FPolygonAreaLevel> Levels;
+
+	/** Builds bounds for the Points, returns nullptr if the Points do not form a valid star-shaped polygon */
+	static FPolygonAreaShapePtr Build(TArray<FVector2D> Points);
+
+	/** Returns true if the Points go counter-clockwise around the origin and every side is visible from it */
+	static bool IsStarShaped(TArrayView<const FVector2D> Points);
+
+	/** Builds the Levels pyramid from the Points, along with the Hull of every level */
+	void BuildLevels();
+
+	/** Returns heap memory used by the Points and all Levels, including their hulls */
+	SIZE_T GetAllocatedSize() const;
+};
\ No newline at end of file
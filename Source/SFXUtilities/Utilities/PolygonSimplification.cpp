@@ -0,0 +1,122 @@
+#include "PolygonSimplification.h"
+
+namespace
+{
+	struct FRemovalCandidate
+	{
+		float Cost;
+		int32 Index;
+		uint32 Version;
+
+		bool operator<(const FRemovalCandidate& Other) const { return Cost < Other.Cost; }
+	};
+
+	float DistToSegment(const FVector2D& Point, const FVector2D& A, const FVector2D& B)
+	{
+		return FVector2D::Distance(FMath::ClosestPointOnSegment2D(Point, A, B), Point);
+	}
+}
+
+namespace Utils
+{
+	namespace PolygonSimplification
+	{
+		float Simplify(TArrayView<const FVector2D> Points, int32 TargetNum, float MaxError, float MinRadius, TArray<FVector2D>& OutPoints)
+		{
+			const int32 N = Points.Num();
+			TargetNum = FMath::Max(TargetNum, 3);
+
+			// Doubly linked list of kept vertices
+			TArray<int32> Prev, Next;
+			Prev.SetNumUninitialized(N);
+			Next.SetNumUninitialized(N);
+			for (int32 i = 0; i < N; i++)
+			{
+				Prev[i] = (i == 0) ? N - 1 : i - 1;
+				Next[i] = (i == N - 1) ? 0 : i + 1;
+			}
+
+			// Error accumulated by the side beginning at the vertex
+			TArray<float> SideError;
+			SideError.SetNumZeroed(N);
+
+			// Invalidates stale heap entries
+			TArray<uint32> Versions;
+			Versions.SetNumZeroed(N);
+
+			auto GetCost = [&](int32 Index)
+			{
+				const FVector2D& A = Points[Prev[Index]];
+				const FVector2D& B = Points[Next[Index]];
+
+				if (!IsValidSide(A, B, MinRadius)) return MAX_FLT;
+
+				return FMath::Max(SideError[Prev[Index]], SideError[Index]) + DistToSegment(Points[Index], A, B);
+			};
+
+			TArray<FRemovalCandidate> Heap;
+			Heap.Reserve(N);
+			for (int32 i = 0; i < N; i++)
+			{
+				Heap.Add({ GetCost(i), i, 0u });
+			}
+			Heap.Heapify();
+
+			int32 NumKept = N;
+			float TotalError = 0.f;
+
+			while (NumKept > TargetNum && Heap.Num() > 0)
+			{
+				FRemovalCandidate Candidate;
+				Heap.HeapPop(Candidate, false);
+
+				if (Candidate.Version != Versions[Candidate.Index]) continue;
+
+				// Cheapest removal would break the polygon or exceed the error
+				if (Candidate.Cost >= MAX_FLT || Candidate.Cost > MaxError) break;
+
+				const int32 PrevIdx = Prev[Candidate.Index];
+				const int32 NextIdx = Next[Candidate.Index];
+
+				Next[PrevIdx] = NextIdx;
+				Prev[NextIdx] = PrevIdx;
+				SideError[PrevIdx] = Candidate.Cost;
+				Prev[Candidate.Index] = INDEX_NONE;
+
+				TotalError = FMath::Max(TotalError, Candidate.Cost);
+				NumKept--;
+
+				// Neighbours form new sides, so their costs change
+				for (int32 Neighbour : { PrevIdx, NextIdx })
+				{
+					Heap.HeapPush({ GetCost(Neighbour), Neighbour, ++Versions[Neighbour] });
+				}
+			}
+
+			OutPoints.Reset(NumKept);
+
+			// Walk the kept vertices in the original order
+			int32 First = 0;
+			while (Prev[First] == INDEX_NONE) First++;
+
+			int32 Index = First;
+			do
+			{
+				OutPoints.Add(Points[Index]);
+				Index = Next[Index];
+			}
+			while (Index != First);
+
+			return TotalError;
+		}
+
+		bool IsValidSide(const FVector2D& A, const FVector2D& B, float MinRadius)
+		{
+			const FVector2D Line = A - B;
+			if ((Line ^ B) <= 0.f) return false;
+
+			const FVector2D Norm = B - Line * ((B | Line) / (Line | Line));
+			return Norm.SizeSquared() >= MinRadius * MinRadius;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace Utils
+{
+	namespace PolygonSimplification
+	{
+		/**
+		 * Removes vertices of the star-shaped Points, least deviating first (Visvalingam style), until TargetNum vertices remain
+		 * or the next removal would move the boundary further than MaxError
+		 * Kept sides stay visible from the origin and no closer to it than MinRadius
+		 * Returns the conservative max distance between the original and the simplified boundaries
+		 */
+		SFXUTILITIES_API float Simplify(TArrayView<const FVector2D> Points, int32 TargetNum, float MaxError, float MinRadius, TArray<FVector2D>& OutPoints);
+
+		/** Returns true if the side (A, B) is visible from the origin and is no closer to it than MinRadius */
+		SFXUTILITIES_API bool IsValidSide(const FVector2D& A, const FVector2D& B, float MinRadius);
+	}
+}
\ No newline at end of file
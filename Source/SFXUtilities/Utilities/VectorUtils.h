@@ -5,17 +5,17 @@
 
 namespace Utils
 {
-	const FVector2D& As2D(const FVector& V)
+	FORCEINLINE const FVector2D& As2D(const FVector& V)
 	{
 		return *reinterpret_cast<const FVector2D*>(&V.X);
 	}
 
-	FVector2D& As2D(FVector& V)
+	FORCEINLINE FVector2D& As2D(FVector& V)
 	{
 		return *reinterpret_cast<FVector2D*>(&V.X);
 	}
 
-	FVector To3D(const FVector2D& V)
+	FORCEINLINE FVector To3D(const FVector2D& V)
 	{
 		return FVector(V, 0.f);
 	}
@@ -0,0 +1,47 @@
+#include "VerticalIntervalIndex.h"
+
+#include "Algo/BinarySearch.h"
+
+void FVerticalIntervalIndex::Build(TArrayView<const FFloatInterval> Intervals)
+{
+	Entries.Reset(Intervals.Num());
+
+	for (int32 Index = 0; Index < Intervals.Num(); Index++)
+	{
+		const FFloatInterval& Interval = Intervals[Index];
+		if (Interval.IsValid())
+		{
+			Entries.Add({ Interval.Min, Interval.Max, 0.f, Index });
+		}
+		else
+		{
+			Entries.Add({ -MAX_FLT, MAX_FLT, 0.f, Index });
+		}
+	}
+
+	Entries.Sort([](const FEntry& A, const FEntry& B) { return A.Min < B.Min; });
+
+	float MaxPrefix = -MAX_FLT;
+	for (FEntry& Entry : Entries)
+	{
+		MaxPrefix = FMath::Max(MaxPrefix, Entry.Max);
+		Entry.MaxPrefix = MaxPrefix;
+	}
+}
+
+void FVerticalIntervalIndex::FindOverlapping(float Min, float Max, TArray<int32, TInlineAllocator<8>>& OutIndices) const
+{
+	// Entries starting above the query can't overlap it
+	const int32 End = Algo::UpperBoundBy(Entries, Max, [](const FEntry& Entry) { return Entry.Min; });
+
+	for (int32 i = End - 1; i >= 0; i--)
+	{
+		const FEntry& Entry = Entries[i];
+		if (Entry.MaxPrefix < Min) break;
+
+		if (Entry.Max >= Min)
+		{
+			OutIndices.Add(Entry.Index);
+		}
+	}
+}
\ No newline at end of file
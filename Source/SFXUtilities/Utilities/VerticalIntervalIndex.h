@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/Interval.h"
+
+/**
+ * Finds height intervals overlapping the query interval, without testing all of them
+ * Intervals are sorted by Min, each entry keeps the max of Max over all entries up to it,
+ * so the backward scan stops at the first entry, below which nothing can reach the query
+ */
+class SFXUTILITIES_API FVerticalIntervalIndex
+{
+public:
+	/** Invalid intervals are treated as infinitely tall */
+	void Build(TArrayView<const FFloatInterval> Intervals);
+
+	/** Collects indices (in the Build order) of the intervals overlapping [Min, Max] */
+	void FindOverlapping(float Min, float Max, TArray<int32, TInlineAllocator<8>>& OutIndices) const;
+
+	int32 Num() const { return Entries.Num(); }
+	SIZE_T GetAllocatedSize() const { return Entries.GetAllocatedSize(); }
+
+private:
+	struct FEntry
+	{
+		float Min;
+		float Max;
+		float MaxPrefix; // Max of Max over this and all previous entries
+		int32 Index;
+	};
+
+	TArray<FEntry> Entries;
+};
\ No newline at end of file
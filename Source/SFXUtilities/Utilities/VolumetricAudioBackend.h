@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UFMODEvent;
+
+/** Event instance owned by the audio backend, opaque to emitters */
+struct FVolumetricAudioInstance
+{
+	FVolumetricAudioInstance()
+		: Handle(0)
+	{}
+
+	explicit FVolumetricAudioInstance(UPTRINT InHandle)
+		: Handle(InHandle)
+	{}
+
+	bool IsValid() const { return Handle != 0; }
+	void Invalidate() { Handle = 0; }
+
+	UPTRINT GetHandle() const { return Handle; }
+
+private:
+	UPTRINT Handle;
+};
+
+/**
+ * Audio operations volumetric emitters need, so the emitter pipeline runs and is profiled
+ * with or without the audio middleware (see FFMODVolumetricAudioBackend and FNullVolumetricAudioBackend)
+ * Instance functions expect a valid instance acquired from the same backend
+ */
+class SFXUTILITIES_API IVolumetricAudioBackend
+{
+public:
+	virtual ~IVolumetricAudioBackend() {}
+
+	/** Returns false if the Event cannot be played or is not 3D, otherwise its max attenuation distance (world units) */
+	virtual bool GetMaxDistance(const UFMODEvent* Event, float& OutMaxDistance) = 0;
+
+	/** Returns a stopped instance of the Event (pooled or newly created), invalid if the Event cannot be played */
+	virtual FVolumetricAudioInstance AcquireInstance(const UFMODEvent* Event) = 0;
+
+	/** Stops the Instance and keeps it for reuse by other emitters of the Event */
+	virtual void ReleaseInstance(const UFMODEvent* Event, FVolumetricAudioInstance Instance) = 0;
+
+	/** Overrides attenuation distances (in FFMODAttenuationDetails units), negative values restore the event ones */
+	virtual void SetAttenuation(FVolumetricAudioInstance Instance, float MinDistance, float MaxDistance) = 0;
+
+	virtual void SetParameter(FVolumetricAudioInstance Instance, FName Name, float Value) = 0;
+
+	/** Moves the Instance to the world Transform */
+	virtual void Set3DAttributes(FVolumetricAudioInstance Instance, const FTransform& Transform) = 0;
+
+	virtual void Start(FVolumetricAudioInstance Instance) = 0;
+
+	/** Stops the Instance, allowing it to fade out */
+	virtual void Stop(FVolumetricAudioInstance Instance) = 0;
+
+	/** Returns memory owned by the Instance */
+	virtual SIZE_T GetInstanceMemory(FVolumetricAudioInstance Instance) const { return 0; }
+
+	/** Sets max number of stopped instances kept for reuse per event */
+	virtual void SetMaxPooledPerEvent(int32 MaxPooled) {}
+};
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include "VolumetricQueryRecording.h"
+
+#include "SFXUtilities/Components/PolygonArea2DComponent.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	constexpr uint32 RecordingMagic = 0x52515656; // "VVQR"
+	constexpr int32 RecordingVersion = 3; // Shape versions with pyramid presence
+}
+
+FArchive& operator<<(FArchive& Ar, FVolumetricAreaRecord& Area)
+{
+	Ar << Area.Name;
+	Ar << Area.Points;
+	Ar << Area.MinBox;
+	Ar << Area.MaxBox;
+	Ar << Area.VerticalExtent;
+	Ar << Area.LevelErrorBudget;
+	Ar << Area.bHasLevels;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FVolumetricQueryRecord& Query)
+{
+	Ar << Query.AreaIndex;
+	Ar << Query.Location;
+	Ar << Query.Radius;
+	Ar << Query.bWithinRadius;
+	Ar << Query.ClosestPoint;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FVolumetricFrameRecord& Frame)
+{
+	Ar << Frame.DeltaTime;
+	Ar << Frame.ListenerLocation;
+	Ar << Frame.ListenerRotation;
+	Ar << Frame.Queries;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FVolumetricQueryRecording& Recording)
+{
+	Ar << Recording.Areas;
+	Ar << Recording.Frames;
+	return Ar;
+}
+
+bool FVolumetricQueryRecording::SaveToFile(const FString& Filename)
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+
+	uint32 Magic = RecordingMagic;
+	int32 Version = RecordingVersion;
+	Writer << Magic;
+	Writer << Version;
+	Writer << *this;
+
+	return FFileHelper::SaveArrayToFile(Data, *Filename);
+}
+
+bool FVolumetricQueryRecording::LoadFromFile(const FString& Filename)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Filename)) return false;
+
+	FMemoryReader Reader(Data);
+
+	uint32 Magic = 0u;
+	int32 Version = 0;
+	Reader << Magic;
+	Reader << Version;
+	if (Magic != RecordingMagic || Version != RecordingVersion) return false;
+
+	Reader << *this;
+	return !Reader.IsError();
+}
+
+void FVolumetricQueryRecorder::RecordQuery(const UPolygonArea2DComponent* Area, const FVector& Location, float Radius, bool bWithinRadius, const FVector& ClosestPoint)
+{
+	FPolygonAreaShapePtr Shape = Area->GetShape();
+	if (!Shape.IsValid()) return;
+
+	// Polygon is stored when the area is queried first and again after every change (runtime edits, async pyramid published)
+	FRecordedArea* RecordedArea = RecordedAreas.Find(Area);
+	const FFloatInterval VerticalExtent = Area->GetVerticalExtent();
+	const bool bChanged = RecordedArea == nullptr || RecordedArea->Shape != Shape
+		|| RecordedArea->VerticalExtent.Min != VerticalExtent.Min || RecordedArea->VerticalExtent.Max != VerticalExtent.Max
+		|| RecordedArea->LevelErrorBudget != Area->GetLevelErrorBudget();
+
+	if (bChanged)
+	{
+		FVolumetricAreaRecord AreaRecord;
+		AreaRecord.Name = Area->GetPathName();
+		AreaRecord.Points = Shape->Points;
+		AreaRecord.MinBox = Shape->MinBox;
+		AreaRecord.MaxBox = Shape->MaxBox;
+		AreaRecord.VerticalExtent = VerticalExtent;
+		AreaRecord.LevelErrorBudget = Area->GetLevelErrorBudget();
+		AreaRecord.bHasLevels = Shape->Levels.Num() > 0;
+
+		RecordedArea = &RecordedAreas.Add(Area, FRecordedArea{ Shape, AreaRecord.VerticalExtent, AreaRecord.LevelErrorBudget, Recording.Areas.Num() });
+		Recording.Areas.Add(MoveTemp(AreaRecord));
+	}
+
+	CurrentFrame.Queries.Add({ RecordedArea->AreaIndex, Location, Radius, bWithinRadius, bWithinRadius ? ClosestPoint : FVector::ZeroVector });
+}
+
+void FVolumetricQueryRecorder::EndFrame(float DeltaTime, const FVector& ListenerLocation, const FRotator& ListenerRotation)
+{
+	CurrentFrame.DeltaTime = DeltaTime;
+	CurrentFrame.ListenerLocation = ListenerLocation;
+	CurrentFrame.ListenerRotation = ListenerRotation;
+
+	Recording.Frames.Add(MoveTemp(CurrentFrame));
+	CurrentFrame = FVolumetricFrameRecord();
+}
+
+FVolumetricReplayResult ReplayVolumetricQueries(const FVolumetricQueryRecording& Recording, float Tolerance, int32 Iterations)
+{
+	FVolumetricReplayResult Result;
+
+	TArray<UPolygonArea2DComponent*> Areas;
+	Areas.Reserve(Recording.Areas.Num());
+	for (const FVolumetricAreaRecord& AreaRecord : Recording.Areas)
+	{
+		UPolygonArea2DComponent* Area = NewObject<UPolygonArea2DComponent>(GetTransientPackage());
+		Area->AddToRoot();
+		Area->SetLevelErrorBudget(AreaRecord.LevelErrorBudget);
+		Area->SetVerticalExtent(AreaRecord.VerticalExtent);
+		Area->InitializeShape(AreaRecord.Points, AreaRecord.MinBox, AreaRecord.MaxBox, AreaRecord.bHasLevels);
+		Areas.Add(Area);
+	}
+
+	for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+	{
+		for (const FVolumetricFrameRecord& Frame : Recording.Frames)
+		{
+			for (const FVolumetricQueryRecord& Query : Frame.Queries)
+			{
+				UPolygonArea2DComponent* Area = Areas[Query.AreaIndex];
+
+				const double StartTime = FPlatformTime::Seconds();
+
+				// Same calls the emitter makes
+				const bool bWithinRadius = Area->IsWithinRadius(Query.Location, Query.Radius);
+				const FVector ClosestPoint = bWithinRadius ? Area->FindClosestPoint(Query.Location) : FVector::ZeroVector;
+
+				Result.QuerySeconds += FPlatformTime::Seconds() - StartTime;
+				Result.NumQueries++;
+
+				if (bWithinRadius != Query.bWithinRadius || !ClosestPoint.Equals(Query.ClosestPoint, Tolerance))
+				{
+					Result.NumMismatches++;
+				}
+			}
+		}
+	}
+
+	for (UPolygonArea2DComponent* Area : Areas)
+	{
+		Area->RemoveFromRoot();
+	}
+
+	return Result;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/Box2D.h"
+#include "Math/Interval.h"
+
+#include "SFXUtilities/Utilities/PolygonAreaShape.h"
+
+class UPolygonArea2DComponent;
+
+/** Area polygon as it was queried during the recording, every published shape of an area is a separate record */
+struct FVolumetricAreaRecord
+{
+	FString Name;
+	TArray<FVector2D> Points;
+	FBox2D MinBox;
+	FBox2D MaxBox;
+	FFloatInterval VerticalExtent; // Invalid if the area is infinitely tall
+	float LevelErrorBudget;
+	bool bHasLevels; // False if queried before the async pyramid build was published
+
+	friend FArchive& operator<<(FArchive& Ar, FVolumetricAreaRecord& Area);
+};
+
+/** Single emitter query inputs (in the area space) and outputs */
+struct FVolumetricQueryRecord
+{
+	int32 AreaIndex;
+	FVector Location;
+	float Radius;
+	bool bWithinRadius;
+	FVector ClosestPoint; // Zero if not bWithinRadius
+
+	friend FArchive& operator<<(FArchive& Ar, FVolumetricQueryRecord& Query);
+};
+
+struct FVolumetricFrameRecord
+{
+	float DeltaTime;
+	FVector ListenerLocation;
+	FRotator ListenerRotation;
+	TArray<FVolumetricQueryRecord> Queries;
+
+	friend FArchive& operator<<(FArchive& Ar, FVolumetricFrameRecord& Frame);
+};
+
+/** Listener path and volumetric queries of a play session */
+struct SFXUTILITIES_API FVolumetricQueryRecording
+{
+	TArray<FVolumetricAreaRecord> Areas;
+	TArray<FVolumetricFrameRecord> Frames;
+
+	bool SaveToFile(const FString& Filename);
+	bool LoadFromFile(const FString& Filename);
+
+	friend FArchive& operator<<(FArchive& Ar, FVolumetricQueryRecording& Recording);
+};
+
+/** Collects the recording frame by frame */
+class SFXUTILITIES_API FVolumetricQueryRecorder
+{
+public:
+	void RecordQuery(const UPolygonArea2DComponent* Area, const FVector& Location, float Radius, bool bWithinRadius, const FVector& ClosestPoint);
+	void EndFrame(float DeltaTime, const FVector& ListenerLocation, const FRotator& ListenerRotation);
+
+	FVolumetricQueryRecording& GetRecording() { return Recording; }
+
+private:
+	/** Latest recorded shape of an area, which is recorded again once it changes */
+	struct FRecordedArea
+	{
+		FPolygonAreaShapePtr Shape; // Kept alive, so a new snapshot never reuses its address
+		FFloatInterval VerticalExtent;
+		float LevelErrorBudget;
+		int32 AreaIndex;
+	};
+
+	FVolumetricQueryRecording Recording;
+	FVolumetricFrameRecord CurrentFrame;
+	TMap<TWeakObjectPtr<const UPolygonArea2DComponent>, FRecordedArea> RecordedAreas;
+};
+
+struct FVolumetricReplayResult
+{
+	int32 NumQueries = 0;
+	int32 NumMismatches = 0;
+	double QuerySeconds = 0.0;
+};
+
+/**
+ * Feeds the recorded queries through transient UPolygonArea2DComponents without a world,
+ * measuring query time and counting results, which differ from the recorded ones by more than Tolerance
+ */
+SFXUTILITIES_API FVolumetricReplayResult ReplayVolumetricQueries(const FVolumetricQueryRecording& Recording, float Tolerance, int32 Iterations = 1);
\ No newline at end of file
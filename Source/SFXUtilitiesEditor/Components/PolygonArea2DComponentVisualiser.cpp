@@ -2,11 +2,12 @@
 
 #include "PolygonArea2DComponentVisualiser.h"
 
+#include "Misc/Crc.h"
 #include "SceneManagement.h"
 
 #include "SFXUtilities/Components/PolygonArea2DComponent.h"
 
-#include "SFXUtilitiesEditor/Utilities/FBoxUtils.h"
+#include "SFXUtilities/Utilities/FBoxUtils.h"
 #include "SFXUtilities/Utilities/VectorUtils.h"
 #include "SFXUtilities/Utilities/ArrayUtils.h"
 
@@ -14,8 +15,37 @@ IMPLEMENT_HIT_PROXY(HAmbientAreaVisProxy, HComponentVisProxy);
 IMPLEMENT_HIT_PROXY(HPointProxy, HAmbientAreaVisProxy);
 IMPLEMENT_HIT_PROXY(HLineProxy, HAmbientAreaVisProxy)
 
+namespace
+{
+	// Sides are culled and thinned in chunks, so huge polygons cost little when mostly off screen or far away
+	constexpr int32 SegmentsPerChunk = 64;
+
+	// Points closer than this on the screen are thinned out
+	constexpr float MinPointSpacingPixels = 8.f;
+
+	// Screen size of heatmap samples (pixels)
+	constexpr float HeatmapPointSize = 8.f;
+
+	// Moved points closer than this to a box bound (area space units) are assumed to have bounded it
+	constexpr float BoxBoundTolerance = 0.1f;
+
+	/** Applies inscribed box constraints of the Chain sides and inner points, the end points are the unmoved neighbours */
+	void InscribeChain(FBox2D& Box, TArrayView<const FVector2D> Chain)
+	{
+		for (int32 Index = 1; Index < Chain.Num(); Index++)
+		{
+			if (Index < Chain.Num() - 1)
+			{
+				Utils::InscribePoint(Box, Chain[Index]);
+			}
+			Utils::InscribeSide(Box, Chain[Index - 1], Chain[Index]);
+		}
+	}
+}
+
 FPolygonArea2DComponentVisualiser::FPolygonArea2DComponentVisualiser()
-	: SelectedPoint(INDEX_NONE)
+	: CurrentHitProxyCache(nullptr)
+	, SelectedPoint(INDEX_NONE)
 	, SelectedLineBegin(INDEX_NONE)
 {
 	AddDelegates();
@@ -48,47 +78,188 @@ void FPolygonArea2DComponentVisualiser::DrawVisualization(const UActorComponent*
 		const auto& Points = AreaComponent->Points;
 		if (Points.Num() < 3) return;
 
-		FMatrix TransformMatrix = AreaComponent->GetOwner()->GetActorTransform().ToMatrixNoScale();
-		FBox MinBox(FVector(AreaComponent->MinBox.Min, -200.f), FVector(AreaComponent->MinBox.Max, 200.f));
-		FBox MaxBox(FVector(AreaComponent->MaxBox.Min, -200.f), FVector(AreaComponent->MaxBox.Max, 200.f));
+		// Infinitely tall areas are drawn with a fixed height
+		const FFloatInterval VerticalExtent = AreaComponent->GetVerticalExtent();
+		const FFloatInterval DrawExtent = VerticalExtent.IsValid() ? VerticalExtent : FFloatInterval(-200.f, 200.f);
+		const float OutlineZ = VerticalExtent.IsValid() ? VerticalExtent.Min : 0.f;
+
+		FMatrix TransformMatrix = AreaComponent->GetOwner()->GetActorTransform().ToMatrixWithScale();
+		FBox MinBox(FVector(AreaComponent->MinBox.Min, DrawExtent.Min), FVector(AreaComponent->MinBox.Max, DrawExtent.Max));
+		FBox MaxBox(FVector(AreaComponent->MaxBox.Min, DrawExtent.Min), FVector(AreaComponent->MaxBox.Max, DrawExtent.Max));
+
+		const FBox WorldBox = MaxBox.TransformBy(TransformMatrix);
+		if (!View->ViewFrustum.IntersectBox(WorldBox.GetCenter(), WorldBox.GetExtent())) return;
+
+		// Heatmap is not clickable, the points and sides drawn over it are
+		if (AreaComponent->bDrawQueryCostHeatmap && !PDI->IsHitTesting())
+		{
+			DrawQueryHeatmap(AreaComponent, TransformMatrix, OutlineZ, PDI);
+		}
+
 		DrawWireBox(PDI, TransformMatrix, MinBox, AreaComponent->EditorBoxColor, SDPG_World, 2.f);
 		DrawWireBox(PDI, TransformMatrix, MaxBox, AreaComponent->EditorBoxColor, SDPG_World, 2.f);
 
-		for (int32 i = 0; i < Points.Num() - 1; i++)
+		WorldPoints.Reset(Points.Num());
+		for (const FVector2D& Point : Points)
 		{
-			DrawSegment(AreaComponent, PDI, i, i + 1);
+			WorldPoints.Add(TransformMatrix.TransformPosition(FVector(Point, OutlineZ)));
 		}
+
+		// Hit proxies are only needed by the hit proxy pass, plain draws go to a single line batch
+		CurrentHitProxyCache = PDI->IsHitTesting() ? &GetHitProxyCache(AreaComponent) : nullptr;
+		const bool bIsSelected = AreaComponent == GetAmbientAreaComponent();
+
+		PDI->AddReserveLines(SDPG_World, Points.Num(), false, true);
+
+		for (int32 ChunkBegin = 0; ChunkBegin < Points.Num(); ChunkBegin += SegmentsPerChunk)
 		{
-			DrawSegment(AreaComponent, PDI, Points.Num() - 1, 0);
+			DrawChunk(AreaComponent, View, PDI, ChunkBegin, FMath::Min(ChunkBegin + SegmentsPerChunk, Points.Num()), bIsSelected);
 		}
+
+		CurrentHitProxyCache = nullptr;
 	}
 }
 
-void FPolygonArea2DComponentVisualiser::DrawSegment(const UPolygonArea2DComponent* AreaComp, FPrimitiveDrawInterface* PDI, int32 BeginIndex, int32 EndIndex)
+void FPolygonArea2DComponentVisualiser::DrawChunk(const UPolygonArea2DComponent* AreaComp, const FSceneView* View, FPrimitiveDrawInterface* PDI, int32 BeginIndex, int32 EndIndex, bool bIsSelected)
 {
-	using namespace Utils;
+	const int32 NumPoints = WorldPoints.Num();
+
+	// Chunk sides end at the first point of the next chunk
+	FBox ChunkBox(ForceInit);
+	for (int32 i = BeginIndex; i <= EndIndex; i++)
+	{
+		ChunkBox += WorldPoints[i % NumPoints];
+	}
+
+	if (!View->ViewFrustum.IntersectBox(ChunkBox.GetCenter(), ChunkBox.GetExtent())) return;
+
+	// Thin points out, so drawn ones are roughly MinPointSpacingPixels apart on the screen
+	const float ScreenSize = ComputeBoundsScreenSize(ChunkBox.GetCenter(), ChunkBox.GetExtent().Size(), *View);
+	const float PointSpacingPixels = ScreenSize * View->UnscaledViewRect.Width() / (EndIndex - BeginIndex);
+	const int32 Stride = PointSpacingPixels > 0.f ? FMath::Clamp(FMath::FloorToInt(MinPointSpacingPixels / PointSpacingPixels), 1, EndIndex - BeginIndex) : EndIndex - BeginIndex;
 
-	auto& Points = AreaComp->Points;
 	const FLinearColor SelectedColor = AreaComp->EditorSelectedColor;
 	const FLinearColor UnselectedColor = AreaComp->EditorUnselectedColor;
 
-	FLinearColor PointColor = (BeginIndex == SelectedPoint) ? SelectedColor : UnselectedColor;
+	for (int32 i = BeginIndex; i < EndIndex; i += Stride)
+	{
+		const int32 NextIndex = FMath::Min(i + Stride, EndIndex);
+
+		if (CurrentHitProxyCache != nullptr)
+		{
+			PDI->SetHitProxy(GetPointProxy(AreaComp, i));
+		}
+		PDI->DrawPoint(WorldPoints[i], (bIsSelected && i == SelectedPoint) ? SelectedColor : UnselectedColor, 20.f, SDPG_World);
+
+		// Thinned sides are drawn as one line, which is selected if any of them is
+		const bool bIsLineSelected = bIsSelected && SelectedLineBegin >= i && SelectedLineBegin < NextIndex;
+
+		if (CurrentHitProxyCache != nullptr)
+		{
+			PDI->SetHitProxy(GetLineProxy(AreaComp, i));
+		}
+		PDI->DrawLine(WorldPoints[i], WorldPoints[NextIndex % NumPoints], bIsLineSelected ? SelectedColor : UnselectedColor, SDPG_World, 3.0f);
+	}
 
-	FVector BeginPointLocal = To3D(Points[BeginIndex]);
-	FVector EndPointLocal = To3D(Points[EndIndex]);
+	// Selected point is never thinned out
+	if (bIsSelected && SelectedPoint >= BeginIndex && SelectedPoint < EndIndex && (SelectedPoint - BeginIndex) % Stride != 0)
+	{
+		if (CurrentHitProxyCache != nullptr)
+		{
+			PDI->SetHitProxy(GetPointProxy(AreaComp, SelectedPoint));
+		}
+		PDI->DrawPoint(WorldPoints[SelectedPoint], SelectedColor, 20.f, SDPG_World);
+	}
 
-	FVector BeginPoint(AreaComp->GetOwner()->GetActorLocation() + BeginPointLocal);
-	FVector EndPoint(AreaComp->GetOwner()->GetActorLocation() + EndPointLocal);
+	if (CurrentHitProxyCache != nullptr)
+	{
+		PDI->SetHitProxy(nullptr);
+	}
+}
 
-	PDI->SetHitProxy(new HPointProxy(AreaComp, BeginIndex));
-	PDI->DrawPoint(BeginPoint, PointColor, 20.f, SDPG_World);
-	PDI->SetHitProxy(nullptr);
+void FPolygonArea2DComponentVisualiser::DrawQueryHeatmap(const UPolygonArea2DComponent* AreaComp, const FMatrix& TransformMatrix, float OutlineZ, FPrimitiveDrawInterface* PDI)
+{
+	const auto& Points = AreaComp->Points;
+
+	// Any edit of the points, boxes or heatmap settings invalidates the samples
+	uint32 Checksum = FCrc::MemCrc32(Points.GetData(), Points.Num() * sizeof(FVector2D));
+	Checksum = FCrc::MemCrc32(&AreaComp->MinBox.Min, sizeof(FVector2D), Checksum);
+	Checksum = FCrc::MemCrc32(&AreaComp->MinBox.Max, sizeof(FVector2D), Checksum);
+	Checksum = FCrc::MemCrc32(&AreaComp->MaxBox.Min, sizeof(FVector2D), Checksum);
+	Checksum = FCrc::MemCrc32(&AreaComp->MaxBox.Max, sizeof(FVector2D), Checksum);
+	Checksum = HashCombine(Checksum, GetTypeHash(AreaComp->QueryHeatmapMargin));
+	Checksum = HashCombine(Checksum, GetTypeHash(AreaComp->QueryHeatmapResolution));
+	Checksum = HashCombine(Checksum, GetTypeHash(AreaComp->QueryHeatmapMaxSides));
+
+	// Forget heatmaps of destroyed components
+	for (auto It = QueryHeatmaps.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
 
-	FLinearColor LineColor = (BeginIndex == SelectedLineBegin) ? SelectedColor : UnselectedColor;
+	FQueryHeatmap& Heatmap = QueryHeatmaps.FindOrAdd(AreaComp);
+	if (Heatmap.Colors.Num() == 0 || Heatmap.Checksum != Checksum)
+	{
+		SampleQueryHeatmap(AreaComp, OutlineZ, Heatmap);
+		Heatmap.Checksum = Checksum;
+	}
 
-	PDI->SetHitProxy(new HLineProxy(AreaComp, BeginIndex));
-	PDI->DrawLine(BeginPoint, EndPoint, LineColor, SDPG_World, 3.0f);
-	PDI->SetHitProxy(nullptr);
+	const FVector2D Step = Heatmap.SampledBox.GetSize() / (Heatmap.Resolution - 1);
+	for (int32 Y = 0; Y < Heatmap.Resolution; Y++)
+	{
+		for (int32 X = 0; X < Heatmap.Resolution; X++)
+		{
+			const FVector2D Location = Heatmap.SampledBox.Min + Step * FVector2D(X, Y);
+			PDI->DrawPoint(TransformMatrix.TransformPosition(FVector(Location, OutlineZ)), Heatmap.Colors[Y * Heatmap.Resolution + X], HeatmapPointSize, SDPG_World);
+		}
+	}
+}
+
+void FPolygonArea2DComponentVisualiser::SampleQueryHeatmap(const UPolygonArea2DComponent* AreaComp, float OutlineZ, FQueryHeatmap& Heatmap)
+{
+	const int32 MaxSides = AreaComp->QueryHeatmapMaxSides;
+
+	Heatmap.Resolution = AreaComp->QueryHeatmapResolution;
+	Heatmap.SampledBox = AreaComp->MaxBox.ExpandBy(AreaComp->QueryHeatmapMargin);
+	Heatmap.Colors.Reset(Heatmap.Resolution * Heatmap.Resolution);
+
+	int32 NumSidesVisited = 0;
+	int32 MaxSidesVisited = 0;
+
+	const FVector2D Step = Heatmap.SampledBox.GetSize() / (Heatmap.Resolution - 1);
+	for (int32 Y = 0; Y < Heatmap.Resolution; Y++)
+	{
+		for (int32 X = 0; X < Heatmap.Resolution; X++)
+		{
+			const FVector2D Location = Heatmap.SampledBox.Min + Step * FVector2D(X, Y);
+			const FPolygonAreaQueryStats Stats = AreaComp->MeasureQueryCost(FVector(Location, OutlineZ));
+
+			NumSidesVisited += Stats.NumSidesVisited;
+			MaxSidesVisited = FMath::Max(MaxSidesVisited, Stats.NumSidesVisited);
+
+			if (!Stats.bSectorTested)
+			{
+				// Inscribed box early-out
+				Heatmap.Colors.Add(FLinearColor(0.f, 0.3f, 1.f));
+			}
+			else if (Stats.NumSidesVisited == 0)
+			{
+				// Sector triangle early-out
+				Heatmap.Colors.Add(FLinearColor::Green);
+			}
+			else
+			{
+				const float Cost = FMath::Min(static_cast<float>(Stats.NumSidesVisited) / MaxSides, 1.f);
+				Heatmap.Colors.Add(FLinearColor::LerpUsingHSV(FLinearColor::Yellow, FLinearColor::Red, Cost));
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("%s: query cost heatmap of %d samples, %.2f sides walked on average, %d at most"),
+		*AreaComp->GetPathName(), Heatmap.Colors.Num(), static_cast<float>(NumSidesVisited) / Heatmap.Colors.Num(), MaxSidesVisited);
 }
 
 bool FPolygonArea2DComponentVisualiser::VisProxyHandleClick(FEditorViewportClient* InViewportClient, HComponentVisProxy* VisProxy, const FViewportClick& Click)
@@ -143,12 +314,16 @@ bool FPolygonArea2DComponentVisualiser::GetWidgetLocation(const FEditorViewportC
 	{
 		using namespace Utils;
 
-		FVector OwnerLocation = TargetComponent->GetOwner()->GetActorLocation();
+		const FTransform& OwnerTransform = TargetComponent->GetOwner()->GetActorTransform();
+
+		// Outline of an extruded area is drawn at its bottom
+		const FFloatInterval VerticalExtent = TargetComponent->GetVerticalExtent();
+		const float OutlineZ = VerticalExtent.IsValid() ? VerticalExtent.Min : 0.f;
 
 		const auto& Points = TargetComponent->Points;
 		if (Points.IsValidIndex(SelectedPoint))
 		{
-			OutLocaction = OwnerLocation + To3D(Points[SelectedPoint]);
+			OutLocaction = OwnerTransform.TransformPosition(FVector(Points[SelectedPoint], OutlineZ));
 
 			bHasLocation = true;
 		}
@@ -156,7 +331,7 @@ bool FPolygonArea2DComponentVisualiser::GetWidgetLocation(const FEditorViewportC
 		{
 			int32 SelectedLineEnd = GetCyclic(Points).Next(SelectedLineBegin);
 			FVector2D MidPoint = 0.5f * (Points[SelectedLineBegin] + Points[SelectedLineEnd]);
-			OutLocaction = OwnerLocation + To3D(MidPoint);
+			OutLocaction = OwnerTransform.TransformPosition(FVector(MidPoint, OutlineZ));
 
 			bHasLocation = true;
 		}
@@ -174,9 +349,11 @@ bool FPolygonArea2DComponentVisualiser::HandleInputDelta(FEditorViewportClient*
 	{
 		using namespace Utils;
 
-		DeltaTranslate.Z = 0.f;
+		// Points are edited in the area space, which may be rotated and scaled
+		FVector LocalDelta = TargetComponent->GetOwner()->GetActorTransform().InverseTransformVector(DeltaTranslate);
+		LocalDelta.Z = 0.f;
 
-		FVector2D &Delta2D = As2D(DeltaTranslate);
+		FVector2D &Delta2D = As2D(LocalDelta);
 
 		auto& Points = TargetComponent->Points;
 		if (Points.IsValidIndex(SelectedPoint))
@@ -185,7 +362,7 @@ bool FPolygonArea2DComponentVisualiser::HandleInputDelta(FEditorViewportClient*
 
 			Points[SelectedPoint] += Delta2D;
 
-			UpdateBoxes(SelectedPoint);
+			UpdateBoxes(SelectedPoint, 1, Delta2D);
 
 			bHandled = true;
 		}
@@ -199,8 +376,7 @@ bool FPolygonArea2DComponentVisualiser::HandleInputDelta(FEditorViewportClient*
 			Points[SelectedLineBegin] += Delta2D;
 			Points[SelectedLineEnd] += Delta2D;
 
-			UpdateBoxes(SelectedLineBegin);
-			UpdateBoxes(SelectedLineEnd);
+			UpdateBoxes(SelectedLineBegin, 2, Delta2D);
 
 			bHandled = true;
 		}
@@ -209,6 +385,15 @@ bool FPolygonArea2DComponentVisualiser::HandleInputDelta(FEditorViewportClient*
 	return bHandled;
 }
 
+void FPolygonArea2DComponentVisualiser::TrackingStopped(FEditorViewportClient* InViewportClient, bool bInDidMove)
+{
+	// Boxes are recomputed once per drag, so the saved inscribed box matches the one a full Inscribe gives
+	if (bInDidMove)
+	{
+		UpdateBoxes();
+	}
+}
+
 bool FPolygonArea2DComponentVisualiser::HandleInputKey(FEditorViewportClient* ViewportClient, FViewport* Viewport, FKey Key, EInputEvent Event)
 {
 	auto TargetComponent = GetAmbientAreaComponent();
@@ -264,7 +449,53 @@ UPolygonArea2DComponent* FPolygonArea2DComponentVisualiser::GetAmbientAreaCompon
 	return Cast<UPolygonArea2DComponent>(ComponentPropertyPath.GetComponent());
 }
 
-void FPolygonArea2DComponentVisualiser::UpdateBoxes(int32 Index)
+FPolygonArea2DComponentVisualiser::FHitProxyCache& FPolygonArea2DComponentVisualiser::GetHitProxyCache(const UActorComponent* Component)
+{
+	// Forget proxies of destroyed components
+	for (auto It = HitProxyCaches.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	return HitProxyCaches.FindOrAdd(Component);
+}
+
+HPointProxy* FPolygonArea2DComponentVisualiser::GetPointProxy(const UActorComponent* Component, int32 PointIndex)
+{
+	auto& PointProxies = CurrentHitProxyCache->PointProxies;
+	if (PointIndex >= PointProxies.Num())
+	{
+		PointProxies.SetNum(PointIndex + 1);
+	}
+
+	if (!PointProxies[PointIndex].IsValid())
+	{
+		PointProxies[PointIndex] = new HPointProxy(Component, PointIndex);
+	}
+
+	return PointProxies[PointIndex];
+}
+
+HLineProxy* FPolygonArea2DComponentVisualiser::GetLineProxy(const UActorComponent* Component, int32 BeginPointIndex)
+{
+	auto& LineProxies = CurrentHitProxyCache->LineProxies;
+	if (BeginPointIndex >= LineProxies.Num())
+	{
+		LineProxies.SetNum(BeginPointIndex + 1);
+	}
+
+	if (!LineProxies[BeginPointIndex].IsValid())
+	{
+		LineProxies[BeginPointIndex] = new HLineProxy(Component, BeginPointIndex);
+	}
+
+	return LineProxies[BeginPointIndex];
+}
+
+void FPolygonArea2DComponentVisualiser::UpdateBoxes()
 {
 	auto TargetComponent = GetAmbientAreaComponent();
 	if (TargetComponent == nullptr)
@@ -274,28 +505,84 @@ void FPolygonArea2DComponentVisualiser::UpdateBoxes(int32 Index)
 
 	const auto& Points = TargetComponent->Points;
 
-	bool bRebuildMax = true;
-	if (Index != INDEX_NONE)
+	FBox2D& MaxBox = TargetComponent->MaxBox;
+	MaxBox = FBox2D(Points.GetData(), Points.Num());
+
+	FBox2D& MinBox = TargetComponent->MinBox;
+	MinBox = MaxBox;
+
+	Utils::Inscribe(MinBox, Points.GetData(), Points.Num());
+}
+
+void FPolygonArea2DComponentVisualiser::UpdateBoxes(int32 FirstIndex, int32 NumMoved, const FVector2D& Delta)
+{
+	auto TargetComponent = GetAmbientAreaComponent();
+	if (TargetComponent == nullptr)
 	{
-		const FVector2D &Point = Points[Index];
-		FBox2D& MaxBox = TargetComponent->MaxBox;
-		FBox2D OldMaxBox = MaxBox;
+		return;
+	}
+
+	const auto& Points = TargetComponent->Points;
+	auto CyclicPoints = Utils::GetCyclic(Points);
 
-		MaxBox += Point;
+	// Moved points with their unmoved neighbours, before and after the move
+	TArray<FVector2D, TInlineAllocator<4>> OldChain;
+	TArray<FVector2D, TInlineAllocator<4>> NewChain;
 
-		bRebuildMax = (OldMaxBox == MaxBox);
+	OldChain.Add(Points[CyclicPoints.Prev(FirstIndex)]);
+	NewChain.Add(OldChain[0]);
+
+	int32 Index = FirstIndex;
+	for (int32 Step = 0; Step < NumMoved; Step++)
+	{
+		OldChain.Add(Points[Index] - Delta);
+		NewChain.Add(Points[Index]);
+		Index = CyclicPoints.Next(Index);
+	}
+
+	OldChain.Add(Points[Index]);
+	NewChain.Add(Points[Index]);
+
+	// Bounding box only shrinks if one of its extreme points moved inwards, the next extreme point takes a full pass to find
+	FBox2D& MaxBox = TargetComponent->MaxBox;
+	bool bRebuildMax = false;
+	for (int32 ChainIndex = 1; ChainIndex <= NumMoved; ChainIndex++)
+	{
+		const FVector2D& OldPoint = OldChain[ChainIndex];
+		bRebuildMax |= (Delta.X > 0.f && OldPoint.X <= MaxBox.Min.X + BoxBoundTolerance)
+			|| (Delta.X < 0.f && OldPoint.X >= MaxBox.Max.X - BoxBoundTolerance)
+			|| (Delta.Y > 0.f && OldPoint.Y <= MaxBox.Min.Y + BoxBoundTolerance)
+			|| (Delta.Y < 0.f && OldPoint.Y >= MaxBox.Max.Y - BoxBoundTolerance);
 	}
 
 	if (bRebuildMax)
 	{
-		FBox2D& MaxBox = TargetComponent->MaxBox;
 		MaxBox = FBox2D(Points.GetData(), Points.Num());
 	}
+	else
+	{
+		for (int32 ChainIndex = 1; ChainIndex <= NumMoved; ChainIndex++)
+		{
+			MaxBox += NewChain[ChainIndex];
+		}
+	}
 
+	// Inscribed box may only grow if the old points or sides touched it, otherwise the new ones just shrink it further
 	FBox2D& MinBox = TargetComponent->MinBox;
-	MinBox = TargetComponent->MaxBox;
+	const FBox2D ExpandedMinBox = MinBox.ExpandBy(BoxBoundTolerance);
 
-	Utils::Inscribe(MinBox, Points.GetData(), Points.Num());
+	FBox2D TouchedBox = ExpandedMinBox;
+	InscribeChain(TouchedBox, OldChain);
+
+	if (TouchedBox == ExpandedMinBox)
+	{
+		InscribeChain(MinBox, NewChain);
+	}
+	else
+	{
+		MinBox = MaxBox;
+		Utils::Inscribe(MinBox, Points.GetData(), Points.Num());
+	}
 }
 
 void FPolygonArea2DComponentVisualiser::Constrain(int32 Index, FVector2D& Delta)
@@ -50,6 +50,7 @@ public:
 	bool GetWidgetLocation(const FEditorViewportClient* ViewportClient, FVector& OutLocation) const override;
 	bool HandleInputDelta(FEditorViewportClient* ViewportClient, FViewport* Viewport, FVector& DeltaTranslate, FRotator& DeltaRotate, FVector& DeltaScale) override;
 	bool HandleInputKey(FEditorViewportClient* ViewportClient, FViewport* Viewport, FKey Key, EInputEvent Event) override;
+	void TrackingStopped(FEditorViewportClient* InViewportClient, bool bInDidMove) override;
 	// End FComponentVisualizer interface
 
 private:
@@ -65,13 +66,53 @@ private:
 	UPolygonArea2DComponent* GetAmbientAreaComponent() const;
 
 	bool CanDeletePoint(int32 PointIndex);
-	void DrawSegment(const UPolygonArea2DComponent *AreaComp, FPrimitiveDrawInterface* PDI, int32 BeginIndex, int32 EndIndex);
-	void UpdateBoxes(int32 Index = INDEX_NONE);
+	void DrawChunk(const UPolygonArea2DComponent *AreaComp, const FSceneView* View, FPrimitiveDrawInterface* PDI, int32 BeginIndex, int32 EndIndex, bool bIsSelected);
+	void UpdateBoxes();
+	/**
+	 * Updates the boxes after NumMoved consecutive points from FirstIndex were moved by Delta, full recompute only happens if they bounded a box.
+	 * The inscribed box may end up smaller than a full recompute would make it, so the drag end recomputes it once
+	 */
+	void UpdateBoxes(int32 FirstIndex, int32 NumMoved, const FVector2D& Delta);
 	void Constrain(int32 Index, FVector2D& Delta);
 	void ConstrainByHalfPlane(FVector2D& V, const FVector2D& VecCCW, const FVector2D& VecCW);
 	void ConstrainByRadius(FVector2D& V, const FVector2D& VAdj, const float PlainSig);
 	// End Helpers
 
+	// Begin Hit proxies
+	/** Hit proxies are kept between frames instead of allocating one per point and side on every hit test */
+	struct FHitProxyCache
+	{
+		TArray<TRefCountPtr<HPointProxy>> PointProxies;
+		TArray<TRefCountPtr<HLineProxy>> LineProxies;
+	};
+
+	FHitProxyCache& GetHitProxyCache(const UActorComponent* Component);
+	HPointProxy* GetPointProxy(const UActorComponent* Component, int32 PointIndex);
+	HLineProxy* GetLineProxy(const UActorComponent* Component, int32 BeginPointIndex);
+
+	TMap<TWeakObjectPtr<const UActorComponent>, FHitProxyCache> HitProxyCaches;
+	FHitProxyCache* CurrentHitProxyCache;
+	// End Hit proxies
+
+	// Begin Query cost heatmap
+	/** Query cost colors sampled on a grid over the area, resampled only when the polygon or heatmap settings change */
+	struct FQueryHeatmap
+	{
+		uint32 Checksum = 0;
+		FBox2D SampledBox = FBox2D(ForceInit);
+		int32 Resolution = 0;
+		TArray<FLinearColor> Colors;
+	};
+
+	void DrawQueryHeatmap(const UPolygonArea2DComponent* AreaComp, const FMatrix& TransformMatrix, float OutlineZ, FPrimitiveDrawInterface* PDI);
+	void SampleQueryHeatmap(const UPolygonArea2DComponent* AreaComp, float OutlineZ, FQueryHeatmap& Heatmap);
+
+	TMap<TWeakObjectPtr<const UActorComponent>, FQueryHeatmap> QueryHeatmaps;
+	// End Query cost heatmap
+
+	/** Area points transformed to the world space once per draw */
+	TArray<FVector> WorldPoints;
+
 	FComponentPropertyPath ComponentPropertyPath;
 
 	int32 SelectedPoint;
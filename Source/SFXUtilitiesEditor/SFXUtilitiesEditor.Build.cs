@@ -32,7 +32,9 @@ public class SFXUtilitiesEditor : ModuleRules
 			//"AppFramework",
 			//"SlateCore",
 			//"AnimGraph",
-			"UnrealEd"
+			"UnrealEd",
+			"Json",
+			"FMODStudio"
 			//"KismetWidgets",
 			//"MainFrame",
 			//"PropertyEditor",
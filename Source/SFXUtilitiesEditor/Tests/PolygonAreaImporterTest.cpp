@@ -0,0 +1,208 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Utilities/PolygonAreaImporter.h"
+
+#include "SFXUtilities/Utilities/PolygonAreaShape.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	struct FGeoJsonFixture
+	{
+		const TCHAR* Name;
+		const TCHAR* Json;
+		TArray<int32> OutlineNumPoints; // Expected outlines, as the number of source points of each
+	};
+
+	TArray<FGeoJsonFixture> MakeGeoJsonFixtures()
+	{
+		return {
+			{
+				TEXT("Polygon with holes"),
+				TEXT("{\"type\":\"Feature\",\"geometry\":{\"type\":\"Polygon\",\"coordinates\":[")
+				TEXT("[[0,0],[10,0],[10,10],[0,10],[0,0]],")
+				TEXT("[[2,2],[4,2],[4,4],[2,2]],")
+				TEXT("[[6,6],[8,6],[8,8],[6,6]]]}}"),
+				{ 5 }
+			},
+			{
+				TEXT("Type after coordinates"),
+				TEXT("{\"coordinates\":[[[0,0,5],[10,0,5],[10,10,5],[0,0,5]]],\"type\":\"Polygon\"}"),
+				{ 4 }
+			},
+			{
+				TEXT("MultiPolygon"),
+				TEXT("{\"type\":\"MultiPolygon\",\"coordinates\":[")
+				TEXT("[[[0,0],[10,0],[10,10],[0,0]],[[2,1],[3,1],[3,2],[2,1]]],")
+				TEXT("[[[20,0],[30,0],[30,10],[20,10],[20,0]]]]}"),
+				{ 4, 5 }
+			},
+			{
+				TEXT("Feature collection"),
+				TEXT("{\"type\":\"FeatureCollection\",\"features\":[")
+				TEXT("{\"type\":\"Feature\",\"properties\":{\"type\":\"Park\"},\"geometry\":{\"type\":\"Polygon\",\"coordinates\":[[[0,0],[1,0],[1,1],[0,0]]]}},")
+				TEXT("{\"type\":\"Feature\",\"geometry\":{\"type\":\"LineString\",\"coordinates\":[[0,0],[1,0],[1,1]]}},")
+				TEXT("{\"type\":\"Feature\",\"geometry\":{\"type\":\"GeometryCollection\",\"geometries\":[")
+				TEXT("{\"type\":\"MultiPolygon\",\"coordinates\":[[[[5,5],[6,5],[6,6],[5,5]]]]}]}}]}"),
+				{ 4, 4 }
+			},
+			{
+				TEXT("Rejected geometries"),
+				TEXT("{\"type\":\"FeatureCollection\",\"features\":[")
+				TEXT("{\"type\":\"Feature\",\"geometry\":{\"type\":\"Point\",\"coordinates\":[0,0]}},")
+				TEXT("{\"type\":\"Feature\",\"geometry\":{\"type\":\"MultiPoint\",\"coordinates\":[[0,0],[1,1]]}},")
+				TEXT("{\"type\":\"Feature\",\"geometry\":{\"type\":\"LineString\",\"coordinates\":[[0,0],[1,0],[1,1],[0,0]]}},")
+				TEXT("{\"type\":\"Feature\",\"geometry\":{\"type\":\"MultiLineString\",\"coordinates\":[[[0,0],[1,0],[1,1],[0,0]],[[2,2],[3,2],[3,3]]]}},")
+				TEXT("{\"type\":\"Feature\",\"geometry\":{\"coordinates\":[[[0,0],[1,0],[1,1],[0,0]]]}}]}"),
+				{}
+			},
+		};
+	}
+
+	struct FCsvFixture
+	{
+		const TCHAR* Name;
+		const TCHAR* Csv;
+		TArray<int32> OutlineNumPoints; // Expected outlines, as the number of source points of each
+	};
+
+	TArray<FCsvFixture> MakeCsvFixtures()
+	{
+		return {
+			{
+				TEXT("Header and two outlines"),
+				TEXT("id,x,y\n")
+				TEXT("a,0,0\na,10,0\na,10,10\na,0,10\n")
+				TEXT("b,20,0\nb,30,0\nb,30,10\n"),
+				{ 4, 3 }
+			},
+			{
+				TEXT("Semicolons, CRLF and no final newline"),
+				TEXT("1;0.5;0.5\r\n1;10.5;0.5\r\n1;10.5;10.5\r\n2;0;0\r\n2;-10;0\r\n2;-10;-10"),
+				{ 3, 3 }
+			},
+			{
+				TEXT("Malformed rows"),
+				TEXT("a,0,0\na,x,0\na,10\na,10,0\n\na,10,10\n"),
+				{ 3 }
+			},
+			{
+				TEXT("Same id apart"),
+				TEXT("a,0,0\na,1,0\na,1,1\nb,5,5\nb,6,5\nb,6,6\na,0,0\na,1,0\na,1,1\n"),
+				{ 3, 3, 3 }
+			},
+		};
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPolygonAreaImporterGeoJsonTest, "SFXUtilities.Import.GeoJsonOutlines",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/** Parses GeoJSON fixtures and checks that only the outer rings of Polygon and MultiPolygon geometries become outlines */
+bool FPolygonAreaImporterGeoJsonTest::RunTest(const FString& Parameters)
+{
+	const FString Filename = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("PolygonAreaImporterTest.geojson"));
+
+	for (const FGeoJsonFixture& Fixture : MakeGeoJsonFixtures())
+	{
+		if (!TestTrue(FString::Printf(TEXT("%s: fixture is written"), Fixture.Name), FFileHelper::SaveStringToFile(Fixture.Json, *Filename))) break;
+
+		TArray<TArray<FVector2D>> Outlines;
+		if (!TestTrue(FString::Printf(TEXT("%s: file is parsed"), Fixture.Name), FPolygonAreaImporter::ParseGeoJson(Filename, Outlines))) continue;
+
+		if (!TestEqual(FString::Printf(TEXT("%s: number of outlines"), Fixture.Name), Outlines.Num(), Fixture.OutlineNumPoints.Num())) continue;
+
+		for (int32 i = 0; i < Outlines.Num(); i++)
+		{
+			TestEqual(FString::Printf(TEXT("%s: points of outline %d"), Fixture.Name, i), Outlines[i].Num(), Fixture.OutlineNumPoints[i]);
+		}
+	}
+
+	IFileManager::Get().Delete(*Filename);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPolygonAreaImporterCsvTest, "SFXUtilities.Import.CsvOutlines",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/** Parses CSV fixtures and checks that consecutive rows with the same id form one outline and malformed rows are skipped */
+bool FPolygonAreaImporterCsvTest::RunTest(const FString& Parameters)
+{
+	const FString Filename = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("PolygonAreaImporterTest.csv"));
+
+	for (const FCsvFixture& Fixture : MakeCsvFixtures())
+	{
+		if (!TestTrue(FString::Printf(TEXT("%s: fixture is written"), Fixture.Name), FFileHelper::SaveStringToFile(Fixture.Csv, *Filename))) break;
+
+		TArray<TArray<FVector2D>> Outlines;
+		if (!TestTrue(FString::Printf(TEXT("%s: file is parsed"), Fixture.Name), FPolygonAreaImporter::ParseCsv(Filename, Outlines))) continue;
+
+		if (!TestEqual(FString::Printf(TEXT("%s: number of outlines"), Fixture.Name), Outlines.Num(), Fixture.OutlineNumPoints.Num())) continue;
+
+		for (int32 i = 0; i < Outlines.Num(); i++)
+		{
+			TestEqual(FString::Printf(TEXT("%s: points of outline %d"), Fixture.Name, i), Outlines[i].Num(), Fixture.OutlineNumPoints[i]);
+		}
+	}
+
+	IFileManager::Get().Delete(*Filename);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPolygonAreaImporterBuildAreaTest, "SFXUtilities.Import.BuildArea",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/** Builds areas from source outlines, checking the orientation fix, the star-shape repair and the rejection of degenerate outlines */
+bool FPolygonAreaImporterBuildAreaTest::RunTest(const FString& Parameters)
+{
+	FPolygonAreaImportSettings Settings;
+	Settings.Scale = 1.f;
+	Settings.MinRadius = 0.f;
+
+	struct FOutlineCase
+	{
+		const TCHAR* Name;
+		TArray<FVector2D> Outline;
+		bool bValid;
+		bool bRepaired;
+		int32 NumPoints;
+	};
+
+	const TArray<FOutlineCase> Cases = {
+		// Clockwise ring closed by repeating its first point, as GIS files store them
+		{ TEXT("Clockwise closed square"), { { 0.f, 0.f }, { 0.f, 10.f }, { 10.f, 10.f }, { 10.f, 0.f }, { 0.f, 0.f } }, true, false, 4 },
+		// Centroid and box center both lie in the notch, so the notch is filled in
+		{ TEXT("C shape"), { { 0.f, 0.f }, { 10.f, 0.f }, { 10.f, 2.f }, { 2.f, 2.f }, { 2.f, 8.f }, { 10.f, 8.f }, { 10.f, 10.f }, { 0.f, 10.f } }, true, true, 8 },
+		{ TEXT("Two distinct points"), { { 0.f, 0.f }, { 10.f, 0.f }, { 10.f, 0.f }, { 0.f, 0.f } }, false, false, 0 },
+		{ TEXT("Collinear points"), { { 0.f, 0.f }, { 5.f, 0.f }, { 10.f, 0.f } }, false, false, 0 },
+	};
+
+	for (const FOutlineCase& Case : Cases)
+	{
+		TArray<FVector2D> Outline = Case.Outline;
+		FPolygonAreaImporter::FImportedArea Area;
+		FPolygonAreaImporter::BuildArea(Outline, Settings, Area);
+
+		TestEqual(FString::Printf(TEXT("%s: is valid"), Case.Name), Area.bValid, Case.bValid);
+		if (!Case.bValid) continue;
+
+		TestEqual(FString::Printf(TEXT("%s: is repaired"), Case.Name), Area.bRepaired, Case.bRepaired);
+		TestEqual(FString::Printf(TEXT("%s: number of points"), Case.Name), Area.Points.Num(), Case.NumPoints);
+		TestTrue(FString::Printf(TEXT("%s: is star-shaped around the area origin"), Case.Name), FPolygonAreaShape::IsStarShaped(Area.Points));
+		TestTrue(FString::Printf(TEXT("%s: inscribed box is inside the bounding box"), Case.Name), Area.MaxBox.IsInside(Area.MinBox));
+	}
+
+	return true;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,495 @@
+#include "PolygonAreaImporter.h"
+
+#include "SFXUtilities/Actors/FMODVolumetricEmitter.h"
+#include "SFXUtilities/Components/PolygonArea2DComponent.h"
+#include "SFXUtilities/Utilities/FBoxUtils.h"
+#include "SFXUtilities/Utilities/PolygonAreaShape.h"
+#include "SFXUtilities/Utilities/PolygonSimplification.h"
+
+#include "FMODAudioComponent.h"
+#include "FMODEvent.h"
+
+#include "Algo/Reverse.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "ScopedTransaction.h"
+#include "Serialization/JsonReader.h"
+
+#define LOCTEXT_NAMESPACE "PolygonAreaImporter"
+
+namespace
+{
+	// CSV files are read in chunks of this size
+	constexpr int32 CsvChunkSize = 64 * 1024;
+
+	FAutoConsoleCommandWithWorldAndArgs ImportAreasCommand(
+		TEXT("sfx.Areas.Import"),
+		TEXT("Imports area outlines from a GeoJSON or CSV (id,x,y) file as volumetric emitters. ")
+		TEXT("Usage: sfx.Areas.Import <File> [Scale=100] [OriginX=0] [OriginY=0] [Z=0] [MaxError=0] [MinRadius=50] [Event=/Game/Path/Event]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (Args.Num() == 0 || World == nullptr) return;
+
+			const FString Params = FString::Join(Args, TEXT(" "));
+
+			FPolygonAreaImportSettings Settings;
+			FParse::Value(*Params, TEXT("Scale="), Settings.Scale);
+			FParse::Value(*Params, TEXT("OriginX="), Settings.Origin.X);
+			FParse::Value(*Params, TEXT("OriginY="), Settings.Origin.Y);
+			FParse::Value(*Params, TEXT("Z="), Settings.Z);
+			FParse::Value(*Params, TEXT("MaxError="), Settings.MaxError);
+			FParse::Value(*Params, TEXT("MinRadius="), Settings.MinRadius);
+
+			FString EventPath;
+			if (FParse::Value(*Params, TEXT("Event="), EventPath))
+			{
+				Settings.Event = LoadObject<UFMODEvent>(nullptr, *EventPath);
+			}
+
+			FPolygonAreaImporter::Import(World, Args[0], Settings);
+		}));
+
+	/** Returns twice the signed area, positive for counter-clockwise polygons */
+	float GetSignedArea2(TArrayView<const FVector2D> Points)
+	{
+		float Area2 = 0.f;
+
+		FVector2D LastPoint = Points.Last();
+		for (const FVector2D& Point : Points)
+		{
+			Area2 += LastPoint ^ Point;
+			LastPoint = Point;
+		}
+
+		return Area2;
+	}
+
+	FVector2D GetCentroid(TArrayView<const FVector2D> Points, float Area2)
+	{
+		FVector2D Centroid = FVector2D::ZeroVector;
+
+		FVector2D LastPoint = Points.Last();
+		for (const FVector2D& Point : Points)
+		{
+			Centroid += (LastPoint + Point) * (LastPoint ^ Point);
+			LastPoint = Point;
+		}
+
+		return Centroid / (3.f * Area2);
+	}
+
+	bool IsStarShapedAround(TArrayView<const FVector2D> Points, const FVector2D& Center)
+	{
+		TArray<FVector2D> Local;
+		Local.Reserve(Points.Num());
+		for (const FVector2D& Point : Points)
+		{
+			Local.Add(Point - Center);
+		}
+
+		return FPolygonAreaShape::IsStarShaped(Local);
+	}
+
+	/**
+	 * Orders the Points by angle around the Center, keeping the farthest of the points on the same ray
+	 * Result is star-shaped around the Center, unless some gap between the points is wider than PI
+	 */
+	void SortAroundCenter(TArray<FVector2D>& Points, const FVector2D& Center)
+	{
+		struct FAngularPoint
+		{
+			float Angle;
+			float DistSqr;
+			FVector2D Point;
+		};
+
+		TArray<FAngularPoint> AngularPoints;
+		AngularPoints.Reserve(Points.Num());
+		for (const FVector2D& Point : Points)
+		{
+			const FVector2D Local = Point - Center;
+			if (Local.IsNearlyZero()) continue;
+
+			AngularPoints.Add({ FMath::Atan2(Local.Y, Local.X), Local.SizeSquared(), Point });
+		}
+
+		AngularPoints.Sort([](const FAngularPoint& A, const FAngularPoint& B) { return A.Angle < B.Angle; });
+
+		Points.Reset();
+		float LastAngle = -MAX_FLT;
+		float LastDistSqr = 0.f;
+		for (const FAngularPoint& AngularPoint : AngularPoints)
+		{
+			if (AngularPoint.Angle - LastAngle < KINDA_SMALL_NUMBER)
+			{
+				if (AngularPoint.DistSqr > LastDistSqr)
+				{
+					Points.Last() = AngularPoint.Point;
+					LastDistSqr = AngularPoint.DistSqr;
+				}
+				continue;
+			}
+
+			Points.Add(AngularPoint.Point);
+			LastAngle = AngularPoint.Angle;
+			LastDistSqr = AngularPoint.DistSqr;
+		}
+	}
+}
+
+int32 FPolygonAreaImporter::Import(UWorld* World, const FString& Filename, const FPolygonAreaImportSettings& Settings)
+{
+	check(World != nullptr);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<TArray<FVector2D>> Outlines;
+	const FString Extension = FPaths::GetExtension(Filename);
+	const bool bParsed = Extension.Equals(TEXT("csv"), ESearchCase::IgnoreCase)
+		? ParseCsv(Filename, Outlines)
+		: ParseGeoJson(Filename, Outlines);
+
+	if (!bParsed)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to parse area outlines from %s"), *Filename);
+		return 0;
+	}
+
+	TArray<FImportedArea> Areas;
+	Areas.SetNum(Outlines.Num());
+
+	ParallelFor(Outlines.Num(), [&](int32 Index)
+	{
+		BuildArea(Outlines[Index], Settings, Areas[Index]);
+	});
+
+	// Actors are spawned on the game thread in one undoable step
+	FScopedTransaction Transaction(LOCTEXT("ImportAreas", "Import Areas"));
+
+	int32 NumSpawned = 0;
+	int32 NumRepaired = 0;
+	for (FImportedArea& ImportedArea : Areas)
+	{
+		if (!ImportedArea.bValid) continue;
+
+		const FTransform Transform(FVector(ImportedArea.Location, Settings.Z));
+
+		// Polygon is set before the components are registered, so editor views and the visualiser see it from the start
+		AFMODVolumetricEmitter* Emitter = World->SpawnActorDeferred<AFMODVolumetricEmitter>(AFMODVolumetricEmitter::StaticClass(), Transform);
+		if (Emitter == nullptr) continue;
+
+		Emitter->SetFlags(RF_Transactional);
+
+		UPolygonArea2DComponent* Area = Emitter->GetArea();
+		Area->InitializeShape(ImportedArea.Points, ImportedArea.MinBox, ImportedArea.MaxBox);
+		Area->MinRadius = Settings.MinRadius;
+
+		if (Settings.Event != nullptr)
+		{
+			Emitter->AudioComponent->SetEvent(Settings.Event);
+		}
+
+		Emitter->FinishSpawning(Transform);
+
+		NumSpawned++;
+		NumRepaired += ImportedArea.bRepaired ? 1 : 0;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Imported %d of %d area outlines from %s in %.2f s (%d repaired to be star-shaped, %d rejected)"),
+		NumSpawned, Outlines.Num(), *Filename, FPlatformTime::Seconds() - StartTime, NumRepaired, Outlines.Num() - NumSpawned);
+
+	return NumSpawned;
+}
+
+bool FPolygonAreaImporter::ParseGeoJson(const FString& Filename, TArray<TArray<FVector2D>>& OutOutlines)
+{
+	TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*Filename));
+	if (!FileReader.IsValid()) return false;
+
+	// Only the coordinates are needed, so the file is walked token by token instead of building the whole document
+	TSharedRef<TJsonReader<ANSICHAR>> Reader = TJsonReaderFactory<ANSICHAR>::Create(FileReader.Get());
+
+	struct FCoordinateArray
+	{
+		int32 IndexInParent;
+		int32 NumChildArrays;
+		int32 NumNumbers;
+		bool bHasPositions;
+	};
+
+	struct FGeometryRing
+	{
+		TArray<FVector2D> Points;
+		int32 Depth; // Number of arrays between the ring and the coordinates
+	};
+
+	// "type" may come after the "coordinates" of an object, so its outer rings are kept until the object ends
+	struct FGeometryObject
+	{
+		FString Type;
+		TArray<FGeometryRing> Rings;
+	};
+
+	TArray<FGeometryObject> Objects;
+	TArray<FCoordinateArray> Stack;
+	TArray<FVector2D> Ring;
+	double Position[2] = { 0.0, 0.0 };
+
+	EJsonNotation Notation;
+	while (Reader->ReadNext(Notation))
+	{
+		if (Stack.Num() == 0)
+		{
+			switch (Notation)
+			{
+			case EJsonNotation::ObjectStart:
+				Objects.AddDefaulted();
+				break;
+			case EJsonNotation::ObjectEnd:
+				{
+					FGeometryObject Object = Objects.Pop(false);
+
+					// Outer rings are the first rings of Polygon coordinates and of each polygon of MultiPolygon coordinates,
+					// other geometries (LineString, MultiLineString, ...) may have nested arrays of the same shape
+					const int32 RingDepth = Object.Type == TEXT("Polygon") ? 1 : Object.Type == TEXT("MultiPolygon") ? 2 : INDEX_NONE;
+					for (FGeometryRing& GeometryRing : Object.Rings)
+					{
+						if (GeometryRing.Depth == RingDepth)
+						{
+							OutOutlines.Add(MoveTemp(GeometryRing.Points));
+						}
+					}
+					break;
+				}
+			case EJsonNotation::String:
+				if (Objects.Num() > 0 && Reader->GetIdentifier() == TEXT("type"))
+				{
+					Objects.Last().Type = Reader->GetValueAsString();
+				}
+				break;
+			case EJsonNotation::ArrayStart:
+				if (Objects.Num() > 0 && Reader->GetIdentifier() == TEXT("coordinates"))
+				{
+					Stack.Add({ 0, 0, 0, false });
+					Ring.Reset();
+				}
+				break;
+			default:
+				break;
+			}
+			continue;
+		}
+
+		switch (Notation)
+		{
+		case EJsonNotation::ArrayStart:
+			{
+				const int32 IndexInParent = Stack.Last().NumChildArrays++;
+				Stack.Add({ IndexInParent, 0, 0, false });
+				break;
+			}
+		case EJsonNotation::Number:
+			{
+				// Positions may have altitude, which is ignored
+				FCoordinateArray& Array = Stack.Last();
+				if (Array.NumNumbers < 2)
+				{
+					Position[Array.NumNumbers] = Reader->GetValueAsNumber();
+				}
+				Array.NumNumbers++;
+				break;
+			}
+		case EJsonNotation::ArrayEnd:
+			{
+				const FCoordinateArray Array = Stack.Pop(false);
+
+				// Top level arrays of points are line strings, not polygons
+				if (Stack.Num() == 0) break;
+
+				if (Array.NumNumbers >= 2)
+				{
+					Ring.Add(FVector2D(Position[0], Position[1]));
+					Stack.Last().bHasPositions = true;
+				}
+				else if (Array.bHasPositions)
+				{
+					// The first ring of a polygon is its outline, the rest are holes
+					if (Array.IndexInParent == 0)
+					{
+						Objects.Last().Rings.Add({ MoveTemp(Ring), Stack.Num() });
+					}
+					Ring.Reset();
+				}
+				break;
+			}
+		default:
+			break;
+		}
+	}
+
+	if (Notation == EJsonNotation::Error)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s: %s"), *Filename, *Reader->GetErrorMessage());
+		return false;
+	}
+
+	return true;
+}
+
+bool FPolygonAreaImporter::ParseCsv(const FString& Filename, TArray<TArray<FVector2D>>& OutOutlines)
+{
+	TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*Filename));
+	if (!FileReader.IsValid()) return false;
+
+	FString CurrentId;
+	TArray<ANSICHAR> Line;
+
+	auto ParseLine = [&]()
+	{
+		Line.Add('\0');
+
+		// Split "id,x,y" in place
+		ANSICHAR* Fields[3] = { Line.GetData(), nullptr, nullptr };
+		int32 NumFields = 1;
+		for (ANSICHAR& Char : Line)
+		{
+			if ((Char == ',' || Char == ';') && NumFields < 3)
+			{
+				Char = '\0';
+				Fields[NumFields++] = &Char + 1;
+			}
+		}
+
+		// Header and malformed rows are skipped
+		if (NumFields < 3) return;
+
+		ANSICHAR* End = nullptr;
+		const double X = FCStringAnsi::Strtod(Fields[1], &End);
+		if (End == Fields[1]) return;
+
+		const double Y = FCStringAnsi::Strtod(Fields[2], &End);
+		if (End == Fields[2]) return;
+
+		const FString Id(Fields[0]);
+		if (OutOutlines.Num() == 0 || Id != CurrentId)
+		{
+			OutOutlines.AddDefaulted();
+			CurrentId = Id;
+		}
+		OutOutlines.Last().Add(FVector2D(X, Y));
+	};
+
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(CsvChunkSize);
+
+	int64 Remaining = FileReader->TotalSize();
+	while (Remaining > 0)
+	{
+		const int32 ChunkSize = static_cast<int32>(FMath::Min<int64>(Remaining, CsvChunkSize));
+		FileReader->Serialize(Buffer.GetData(), ChunkSize);
+		Remaining -= ChunkSize;
+
+		for (int32 i = 0; i < ChunkSize; i++)
+		{
+			const ANSICHAR Char = static_cast<ANSICHAR>(Buffer[i]);
+			if (Char == '\n')
+			{
+				ParseLine();
+				Line.Reset();
+			}
+			else if (Char != '\r')
+			{
+				Line.Add(Char);
+			}
+		}
+	}
+
+	if (Line.Num() > 0)
+	{
+		ParseLine();
+	}
+
+	return !FileReader->IsError();
+}
+
+void FPolygonAreaImporter::BuildArea(TArray<FVector2D>& Outline, const FPolygonAreaImportSettings& Settings, FImportedArea& OutArea)
+{
+	TArray<FVector2D> Points;
+	Points.Reserve(Outline.Num());
+	for (const FVector2D& SourcePoint : Outline)
+	{
+		const FVector2D Point = (SourcePoint - Settings.Origin) * Settings.Scale;
+
+		// GIS rings repeat the first point at the end
+		if (Points.Num() == 0 || !Point.Equals(Points.Last()))
+		{
+			Points.Add(Point);
+		}
+	}
+	Outline.Empty();
+
+	if (Points.Num() > 1 && Points.Last().Equals(Points[0]))
+	{
+		Points.Pop(false);
+	}
+
+	if (Points.Num() < 3) return;
+
+	float Area2 = GetSignedArea2(Points);
+	if (FMath::IsNearlyZero(Area2)) return;
+
+	if (Area2 < 0.f)
+	{
+		// Areas go counter-clockwise
+		Algo::Reverse(Points);
+		Area2 = -Area2;
+	}
+
+	// Most outlines are visible from one of these points as they are
+	const FVector2D Centroid = GetCentroid(Points, Area2);
+	const FVector2D BoxCenter = FBox2D(Points).GetCenter();
+
+	FVector2D Location = Centroid;
+	if (!IsStarShapedAround(Points, Centroid))
+	{
+		if (IsStarShapedAround(Points, BoxCenter))
+		{
+			Location = BoxCenter;
+		}
+		else
+		{
+			// Concavities hidden from the centroid are filled in
+			SortAroundCenter(Points, Centroid);
+			OutArea.bRepaired = true;
+		}
+	}
+
+	for (FVector2D& Point : Points)
+	{
+		Point -= Location;
+	}
+
+	if (!FPolygonAreaShape::IsStarShaped(Points)) return;
+
+	if (Settings.MaxError > 0.f)
+	{
+		TArray<FVector2D> SimplifiedPoints;
+		Utils::PolygonSimplification::Simplify(Points, 4, Settings.MaxError, Settings.MinRadius, SimplifiedPoints);
+		Points = MoveTemp(SimplifiedPoints);
+	}
+
+	OutArea.MaxBox = FBox2D(Points);
+	OutArea.MinBox = OutArea.MaxBox;
+	Utils::Inscribe(OutArea.MinBox, Points.GetData(), Points.Num());
+
+	OutArea.Location = Location;
+	OutArea.Points = MoveTemp(Points);
+	OutArea.bValid = true;
+}
+
+#undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/Box2D.h"
+
+class UWorld;
+class UFMODEvent;
+
+struct FPolygonAreaImportSettings
+{
+	float Scale = 100.f; // World units per source unit (meters to centimeters by default)
+	FVector2D Origin = FVector2D::ZeroVector; // Source point placed at the world origin
+	float Z = 0.f;
+	float MaxError = 0.f; // Outlines are simplified within this error (world units), 0 keeps every point
+	float MinRadius = 50.f; // Simplification keeps sides no closer to the area origin than this
+	UFMODEvent* Event = nullptr; // Event assigned to every imported emitter
+};
+
+/**
+ * Imports area outlines as volumetric emitters from:
+ * - GeoJSON: outer rings of Polygon and MultiPolygon geometries (holes are ignored)
+ * - CSV: "id,x,y" rows, consecutive rows with the same id form one outline
+ * Files are parsed as streams, outlines are validated, repaired to be star-shaped and get their bounds baked in parallel
+ */
+class FPolygonAreaImporter
+{
+	friend class FPolygonAreaImporterGeoJsonTest;
+	friend class FPolygonAreaImporterCsvTest;
+	friend class FPolygonAreaImporterBuildAreaTest;
+
+public:
+	/** Returns the number of spawned emitters */
+	static int32 Import(UWorld* World, const FString& Filename, const FPolygonAreaImportSettings& Settings);
+
+private:
+	struct FImportedArea
+	{
+		FVector2D Location; // Area origin, from which every side is visible
+		TArray<FVector2D> Points;
+		FBox2D MinBox;
+		FBox2D MaxBox;
+		bool bValid = false;
+		bool bRepaired = false;
+	};
+
+	static bool ParseGeoJson(const FString& Filename, TArray<TArray<FVector2D>>& OutOutlines);
+	static bool ParseCsv(const FString& Filename, TArray<TArray<FVector2D>>& OutOutlines);
+
+	/** Converts the source Outline to the area, is called on worker threads */
+	static void BuildArea(TArray<FVector2D>& Outline, const FPolygonAreaImportSettings& Settings, FImportedArea& OutArea);
+};
\ No newline at end of file